@@ -24,69 +24,90 @@
 #include "../../include/adc.h"
 #include "../../include/lcd.h"
 #include "../../include/joystick.h"
+#include "../../include/scheduler.h"
+
+/** Sample rate for the scheduler tick (Hz) */
+#define SAMPLE_RATE_HZ  200
+
+/**
+ * @brief Show a direction string on line 2
+ */
+static void show_direction(joystick_direction_t dir)
+{
+    /* Clear direction area on line 2 */
+    lcd_set_cursor(1, 0);
+    lcd_print_P(PSTR("   "));  /* Clear 3 characters */
+
+    /* Display new direction */
+    lcd_set_cursor(1, 0);
+    lcd_print_P(joystick_direction_to_string_P(dir));
+}
+
+/**
+ * @brief Scheduler tick: pump the event layer and react to transitions
+ *
+ * Runs at a fixed SAMPLE_RATE_HZ. The edge detection lives in the
+ * joystick event layer, so this task only does work when the stick
+ * actually enters or leaves a direction.
+ */
+static void sample_task(void)
+{
+    joystick_event_t event;
+
+    joystick_event_update(scheduler_ticks());
+
+    while (joystick_poll_event(&event)) {
+        switch (event.type) {
+        case JOYSTICK_EVENT_PRESS:
+            show_direction(event.direction);
+            break;
+        case JOYSTICK_EVENT_RELEASE:
+            show_direction(DIR_CENTER);
+            break;
+        case JOYSTICK_EVENT_REPEAT:
+            /* Held direction; nothing extra to draw */
+            break;
+        }
+    }
+}
 
 /**
  * @brief Main entry point
- * 
- * Initializes the LCD and joystick, then continuously reads
- * joystick position and displays the detected direction.
+ *
+ * Initializes the LCD and joystick, then hands control to the
+ * scheduler, which samples at a fixed rate and sleeps the CPU in
+ * idle mode between ticks.
  */
 int main(void)
 {
-    joystick_position_t pos;
-    joystick_direction_t dir;
-    joystick_direction_t last_dir = DIR_CENTER;
-    
     /* Configure LED port as output */
     LED_DDR = 0xFF;
-    
+
     /* Enable global interrupts */
     sei();
-    
-    /* Initialize peripherals */
+
+    /* Start the LCD init state machine first, then bring up the
+     * joystick while the controller's power-up delays elapse: the
+     * stick is sampling within a few ms of reset instead of waiting
+     * 100+ ms behind a blocking lcd_init() */
+    lcd_init_start();
     joystick_init();
-    lcd_init();
-    
+
+    while (!lcd_init_poll(1)) {
+        _delay_ms(1);
+    }
+
     /* Display startup message */
-    lcd_print("Direction:");
+    lcd_print_P(PSTR("Direction:"));
     lcd_set_cursor(1, 0);
-    lcd_print("C");
-    
+    lcd_print_P(PSTR("C"));
+
     _delay_ms(500);
-    
-    while (1) {
-        /* Read joystick position */
-        joystick_read(&pos);
-        
-        /* Determine direction */
-        dir = joystick_get_direction(pos.x, pos.y);
-        
-        /* Only update display if direction changed */
-        if (dir != last_dir) {
-            /* Clear direction area on line 2 */
-            lcd_set_cursor(1, 0);
-            lcd_print("   ");  /* Clear 3 characters */
-            
-            /* Display new direction */
-            lcd_set_cursor(1, 0);
-            lcd_print(joystick_direction_to_string(dir));
-            
-            last_dir = dir;
-        }
-        
-        /* Small delay to debounce */
-        _delay_ms(100);
-    }
-    
-    return 0;
-}
 
-/**
- * @brief ADC Conversion Complete Interrupt
- * 
- * Triggered when ADC conversion completes. Starts the next conversion.
- */
-ISR(ADC_vect)
-{
-    ADCSRA |= (1 << ADSC);  /* Start next conversion */
+    /* Sample at a deterministic fixed rate, sleeping between ticks */
+    scheduler_init(SAMPLE_RATE_HZ);
+    scheduler_add(sample_task);
+    scheduler_run();
+
+    return 0;
 }
@@ -23,84 +23,77 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <util/delay.h>
 #include "../../include/config.h"
 #include "../../include/adc.h"
 #include "../../include/lcd.h"
+#include "../../include/lcd_fb.h"
 #include "../../include/joystick.h"
+#include "../../include/scheduler.h"
+
+/** Scheduler tick rate: also the position sampling rate (Hz) */
+#define TICK_RATE_HZ        500
+
+/** Repaint every 50 ticks = 10 Hz; the eye needs no more */
+#define DISPLAY_PERIOD      (TICK_RATE_HZ / 10)
+
+/* Latest position, shared from the sample task to the display task */
+static joystick_position_t latest_pos;
 
 /**
  * @brief Display X and Y values on LCD
- * 
+ *
+ * Draws into the shadow frame buffer; only cells that actually changed
+ * since the last flush are written to the panel.
+ *
  * @param x X-axis value (0-255)
  * @param y Y-axis value (0-255)
  */
 static void display_coordinates(uint8_t x, uint8_t y)
 {
-    /* Display X value */
-    lcd_set_cursor(0, 0);
-    lcd_print("X=");
-    
-    /* Clear previous X value area */
-    lcd_print("   ");
-    lcd_set_cursor(0, 2);
-    lcd_print_int(x);
-    
-    /* Display Y value */
-    lcd_set_cursor(0, 6);
-    lcd_print("Y=");
-    
-    /* Clear previous Y value area */
-    lcd_print("   ");
-    lcd_set_cursor(0, 8);
-    lcd_print_int(y);
+    lcd_fb_printf(0, 0, "X=%3u Y=%3u", x, y);
+    lcd_fb_flush();
+}
+
+/**
+ * @brief Sample task: runs every tick (500 Hz)
+ */
+static void sample_task(void)
+{
+    joystick_read(&latest_pos);
+}
+
+/**
+ * @brief Display task: runs every DISPLAY_PERIOD ticks (10 Hz)
+ */
+static void display_task(void)
+{
+    display_coordinates(latest_pos.x, latest_pos.y);
 }
 
 /**
  * @brief Main entry point
- * 
- * Initializes the LCD and joystick, then continuously reads
- * and displays X/Y coordinate values.
+ *
+ * Initializes the LCD and joystick, then hands control to the
+ * scheduler: position sampling and display repainting run at their
+ * own rates, with the CPU idle-sleeping between ticks.
  */
 int main(void)
 {
-    joystick_position_t pos;
-    
     /* Configure LED port as output */
     LED_DDR = 0xFF;
-    
+
     /* Enable global interrupts */
     sei();
-    
+
     /* Initialize peripherals */
     joystick_init();
     lcd_init();
-    
-    /* Display labels */
-    lcd_print("X=    Y=");
-    
-    _delay_ms(100);
-    
-    while (1) {
-        /* Read joystick position */
-        joystick_read(&pos);
-        
-        /* Update display with new values */
-        display_coordinates(pos.x, pos.y);
-        
-        /* Delay between readings */
-        _delay_ms(100);
-    }
-    
-    return 0;
-}
+    lcd_fb_init();
 
-/**
- * @brief ADC Conversion Complete Interrupt
- * 
- * Triggered when ADC conversion completes. Starts the next conversion.
- */
-ISR(ADC_vect)
-{
-    ADCSRA |= (1 << ADSC);  /* Start next conversion */
+    scheduler_init(TICK_RATE_HZ);
+    scheduler_add(sample_task);
+    scheduler_add_periodic(display_task, DISPLAY_PERIOD);
+    scheduler_run();
+
+    return 0;
 }
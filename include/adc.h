@@ -21,6 +21,57 @@
  */
 void adc_init(void);
 
+/**
+ * @brief Named acquisition profiles trading accuracy for speed
+ *
+ * The datasheet guarantees full 10-bit accuracy only for ADC clocks of
+ * 50-200 kHz, but 8-bit conversions stay clean up to 1 MHz. FAST runs
+ * the ADC clock at F_CPU/16 (1 MHz at 16 MHz) for an 8x conversion-
+ * throughput gain on 8-bit sampling; ACCURATE keeps the conservative
+ * F_CPU/128 clock for 10-bit work such as calibration capture.
+ *
+ * FAST is meant for bounded on-demand work (blocking reads, burst
+ * captures), not for the continuous free-running scan: at /16 the
+ * conversion-complete ISR fires every 13 us (~208 CPU cycles at
+ * 16 MHz), which the ISR overhead and scan bookkeeping alone largely
+ * consume, and any interrupt backlog spanning two conversions drops a
+ * completion.
+ */
+typedef enum {
+    ADC_PROFILE_ACCURATE = 0,   /**< Prescaler 128, full 10-bit accuracy */
+    ADC_PROFILE_FAST            /**< Prescaler 16, 8-bit gaming-rate sampling */
+} adc_profile_t;
+
+/**
+ * @brief Switch the ADC clock prescaler profile at runtime
+ *
+ * Takes effect from the next conversion. The joystick layer keeps the
+ * continuous scan on ACCURATE and raises the clock to FAST only for
+ * the duration of a burst capture; application code doing its own
+ * blocking 8-bit reads may do the same.
+ *
+ * @param profile Acquisition profile to activate
+ */
+void adc_set_profile(adc_profile_t profile);
+
+/**
+ * @brief Get the active acquisition profile
+ *
+ * @return adc_profile_t Profile last set (ACCURATE after adc_init())
+ */
+adc_profile_t adc_get_profile(void);
+
+/**
+ * @brief Conversion throughput of the active profile
+ *
+ * Free-running conversions take 13 ADC clocks, so this is
+ * F_CPU / (prescaler * 13): ~9.6 kHz for ACCURATE and ~77 kHz for
+ * FAST at 16 MHz.
+ *
+ * @return uint32_t Conversions per second
+ */
+uint32_t adc_conversion_rate_hz(void);
+
 /**
  * @brief Read 10-bit ADC value from specified channel
  * 
@@ -41,10 +92,141 @@ uint8_t adc_read_8bit(uint8_t channel);
 
 /**
  * @brief Convert raw ADC value to percentage
- * 
+ *
  * @param value Raw ADC value (0-255 for 8-bit)
  * @return uint8_t Percentage (0-100)
  */
 uint8_t adc_to_percent(uint8_t value);
 
+/**
+ * @brief Start free-running conversions on a single channel
+ *
+ * Switches the ADC into free-running mode with the conversion-complete
+ * interrupt enabled. Each result is deposited into a double-buffered
+ * per-channel sample register from the ISR, so readers never observe a
+ * half-written sample and never wait on ADSC.
+ *
+ * Global interrupts must be enabled (sei()) for samples to arrive.
+ * The ADC conversion-complete vector is owned by this driver; application
+ * code must not define its own ISR(ADC_vect).
+ *
+ * @param channel ADC channel to convert continuously (0-7)
+ */
+void adc_start_freerun(uint8_t channel);
+
+/**
+ * @brief Convert one channel while sleeping in ADC noise-reduction mode
+ *
+ * Selects the channel, then enters ADC noise-reduction sleep; entering
+ * the sleep state starts the conversion and the conversion-complete
+ * interrupt wakes the CPU (~100 us later at the 125 kHz ADC clock).
+ * The CPU core is halted for the whole conversion, which both cuts
+ * power draw and removes digital switching noise from the result.
+ *
+ * Note that clkIO stops in this sleep mode, so Timer1 (the scheduler
+ * tick) does not advance while inside this call. Must not be called
+ * while the free-running scan engine is active. Global interrupts must
+ * be enabled. The stored scan list is preserved, so a paused scan can
+ * be restarted with adc_scan_resume() afterwards.
+ *
+ * @param channel ADC channel to read (0-7)
+ * @return uint8_t 8-bit conversion result
+ */
+uint8_t adc_sleep_convert(uint8_t channel);
+
+/**
+ * @brief Read an oversampled and decimated value from a channel
+ *
+ * Accumulates 2^log2_samples back-to-back conversions using the ADC
+ * auto-trigger so there is no software restart between samples, then
+ * decimates by half the oversampling exponent. Every 4x oversampling
+ * adds one bit of effective resolution: log2_samples = 2 returns a
+ * 9-bit result, log2_samples = 4 a 10-bit result, and so on.
+ * log2_samples is clamped to 8 (256 samples).
+ *
+ * Blocks for the duration of the burst (~100 us per sample at the
+ * 125 kHz ADC clock). If the free-running scan engine is active it is
+ * paused for the burst and resumed afterwards.
+ *
+ * @param channel ADC channel to read (0-7)
+ * @param log2_samples Oversampling exponent (0-8; samples = 2^n)
+ * @return uint16_t Decimated result, 8 + log2_samples/2 bits wide
+ */
+uint16_t adc_read_oversampled(uint8_t channel, uint8_t log2_samples);
+
+/** Maximum number of entries in a channel scan list */
+#define ADC_SCAN_MAX_CHANNELS   8
+
+/**
+ * @brief Start auto-scanning conversions over a channel list
+ *
+ * Runs the ADC free-running while the conversion-complete ISR cycles
+ * ADMUX round-robin through the given channel list, keeping the
+ * conversion pipeline fully utilized. Results land in the same
+ * double-buffered sample registers served by adc_latest(), so reading
+ * any scanned channel is a zero-wait memory read.
+ *
+ * The list is copied; the caller's array need not stay valid. Lists
+ * longer than ADC_SCAN_MAX_CHANNELS are truncated.
+ *
+ * @param channels Array of ADC channel numbers (each 0-7)
+ * @param count Number of channels in the list (1-ADC_SCAN_MAX_CHANNELS)
+ */
+void adc_scan_start(const uint8_t *channels, uint8_t count);
+
+/**
+ * @brief Stop free-running or scanning conversions
+ *
+ * Disables auto-triggering and the conversion-complete interrupt,
+ * returning the ADC to single-conversion (blocking) mode.
+ */
+void adc_stop_freerun(void);
+
+/**
+ * @brief Restart the last configured channel scan
+ *
+ * Re-arms free-running conversions over the channel list most recently
+ * given to adc_scan_start(), so callers that pause the scan (e.g. for
+ * sleep-mode conversions) can resume it without knowing which list —
+ * the config.h pair or a wider joystick_scan_begin() sequence — was
+ * active. Does nothing if no scan was ever configured.
+ */
+void adc_scan_resume(void);
+
+/**
+ * @brief Check whether the free-running engine is active
+ *
+ * @return uint8_t 1 if free-running conversions are in progress, 0 otherwise
+ */
+uint8_t adc_freerun_active(void);
+
+/** Callback invoked from the conversion-complete ISR for each sample */
+typedef void (*adc_sample_hook_t)(uint8_t channel, uint8_t sample);
+
+/**
+ * @brief Install a per-sample hook on the conversion-complete ISR
+ *
+ * The hook runs in interrupt context immediately after each scanned
+ * sample is published, so latency-critical consumers (e.g. the PWM
+ * drive stage) can react within one conversion period. Keep the hook
+ * short; it executes at the full conversion rate. Pass NULL to remove.
+ *
+ * @param hook Callback, or NULL to disable
+ * @return adc_sample_hook_t Previously installed hook (NULL if none),
+ *         so temporary consumers can restore it when done
+ */
+adc_sample_hook_t adc_set_sample_hook(adc_sample_hook_t hook);
+
+/**
+ * @brief Get the most recent sample for a channel without waiting
+ *
+ * Returns the latest completed conversion stored by the free-running
+ * ISR. This is a plain memory read and never blocks. If no conversion
+ * has completed yet for the channel, returns 0.
+ *
+ * @param channel ADC channel (0-7)
+ * @return uint8_t Latest 8-bit sample for the channel
+ */
+uint8_t adc_latest(uint8_t channel);
+
 #endif /* ADC_H */
@@ -0,0 +1,87 @@
+/**
+ * @file blackbox.h
+ * @brief Black-Box Direction Logger with Wear-Leveled EEPROM Ring
+ *
+ * Records the recent history of stick input for post-fault analysis.
+ * Direction events are run-length encoded into a RAM staging ring as
+ * the stick moves — one two-byte entry per direction change, however
+ * long the direction is held — and written to EEPROM only when
+ * blackbox_commit() is called (typically from a fault handler or a
+ * slow housekeeping task). Commits rotate through a ring of
+ * sequence-numbered EEPROM slots, so wear spreads evenly across the
+ * region and the newest record survives power loss mid-write.
+ *
+ * Write-rate math: raw samples at 500 Hz would burn through the
+ * EEPROM's 100k-cycle endurance in under a day. RLE at direction
+ * granularity means an entry only exists per stick transition, and a
+ * commit only happens on demand, so a unit committing once per fault
+ * plus once a minute of housekeeping stays within endurance for years.
+ */
+
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include <stdint.h>
+
+/** Entries per EEPROM slot (and in the RAM staging ring) */
+#define BLACKBOX_SLOT_ENTRIES   14
+
+/** Number of EEPROM slots the commits rotate through */
+#define BLACKBOX_SLOT_COUNT     8
+
+/**
+ * @brief One run-length encoded direction record
+ */
+typedef struct {
+    uint8_t direction;  /**< joystick_direction_t value */
+    uint8_t run;        /**< Updates the direction persisted (1-255) */
+} blackbox_entry_t;
+
+/**
+ * @brief Locate the newest EEPROM record and reset the staging ring
+ *
+ * Scans the slot ring for the most recent valid sequence number so the
+ * next commit continues the rotation instead of rewriting one cell
+ * group. Call once at startup, before blackbox_commit() or
+ * blackbox_read_slot().
+ */
+void blackbox_init(void);
+
+/**
+ * @brief Feed the logger one classified direction
+ *
+ * Call at the sampling rate (e.g. alongside joystick_event_update()).
+ * Equal consecutive directions extend the current run; a change, or a
+ * run reaching 255, closes the run into the staging ring. The ring
+ * keeps the newest BLACKBOX_SLOT_ENTRIES runs, overwriting the oldest,
+ * so it always holds the last seconds of input. No EEPROM is touched.
+ *
+ * @param direction Current direction (joystick_direction_t)
+ */
+void blackbox_update(uint8_t direction);
+
+/**
+ * @brief Commit the staged history to the next EEPROM slot
+ *
+ * Closes the in-progress run and writes the staging ring, oldest entry
+ * first, into the next slot of the wear-leveled ring. Blocking
+ * (~3.4 ms per changed EEPROM cell, up to ~100 ms per slot) — call
+ * from a fault handler or housekeeping context, never from the
+ * sampling path.
+ *
+ * @return uint8_t Number of entries committed (0 if nothing staged)
+ */
+uint8_t blackbox_commit(void);
+
+/**
+ * @brief Read back a committed slot
+ *
+ * @param age 0 for the newest committed slot, 1 for the one before it,
+ *        up to BLACKBOX_SLOT_COUNT - 1
+ * @param entries Output array of at least BLACKBOX_SLOT_ENTRIES
+ * @return uint8_t Number of valid entries (0 if the slot is empty,
+ *         corrupt or was never written)
+ */
+uint8_t blackbox_read_slot(uint8_t age, blackbox_entry_t *entries);
+
+#endif /* BLACKBOX_H */
@@ -0,0 +1,123 @@
+/**
+ * @file calibration.h
+ * @brief Per-Unit Joystick Calibration with EEPROM Persistence
+ *
+ * Joystick pots vary between units, so the compile-time thresholds in
+ * config.h need wide dead zones to cover the worst batch. This module
+ * captures the actual min/center/max of each axis on a given unit,
+ * stores the profile in EEPROM, and remaps raw samples to a normalized
+ * 0-255 range (center at 128) with precomputed 8.8 fixed-point scale
+ * factors. With normalized input the stock thresholds can stay tight.
+ *
+ * Typical guided capture flow:
+ *   joystick_cal_begin();
+ *   // prompt the user to leave the stick centered, then:
+ *   joystick_cal_sample_center();
+ *   // prompt the user to swirl the stick to full deflection while
+ *   // calling joystick_cal_sample_extents() repeatedly, then:
+ *   joystick_cal_finish();   // validates, stores, activates
+ */
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdint.h>
+
+/**
+ * @brief Captured range of one axis
+ */
+typedef struct {
+    uint8_t min;        /**< Raw reading at full low deflection */
+    uint8_t center;     /**< Raw reading at rest */
+    uint8_t max;        /**< Raw reading at full high deflection */
+} joystick_axis_cal_t;
+
+/**
+ * @brief Per-unit calibration profile (both axes)
+ */
+typedef struct {
+    joystick_axis_cal_t x;  /**< X-axis range */
+    joystick_axis_cal_t y;  /**< Y-axis range */
+} joystick_cal_t;
+
+/**
+ * @brief Load the calibration profile from EEPROM
+ *
+ * Activates normalization if a valid profile is stored. Call once at
+ * startup, after joystick_init(). Units that were never calibrated
+ * keep passing raw values through unchanged.
+ *
+ * @return uint8_t 1 if a valid profile was loaded, 0 otherwise
+ */
+uint8_t joystick_cal_load(void);
+
+/**
+ * @brief Store a calibration profile to EEPROM and activate it
+ *
+ * @param cal Profile to store
+ */
+void joystick_cal_store(const joystick_cal_t *cal);
+
+/**
+ * @brief Check whether normalization is active
+ *
+ * @return uint8_t 1 if a calibration profile is applied, 0 otherwise
+ */
+uint8_t joystick_cal_active(void);
+
+/**
+ * @brief Start a guided capture session
+ *
+ * Resets the working profile; normalization stays in its current state
+ * until joystick_cal_finish() succeeds.
+ */
+void joystick_cal_begin(void);
+
+/**
+ * @brief Record the rest position of both axes
+ *
+ * Averages several raw samples per axis; call while the stick is
+ * released.
+ */
+void joystick_cal_sample_center(void);
+
+/**
+ * @brief Record extent samples for both axes
+ *
+ * Tracks the running min/max of raw readings; call repeatedly while
+ * the user moves the stick to full deflection in all directions.
+ */
+void joystick_cal_sample_extents(void);
+
+/**
+ * @brief Validate, store, and activate the captured profile
+ *
+ * Rejects profiles with implausibly small travel (which would blow up
+ * the scale factors) and leaves the previous state untouched in that
+ * case.
+ *
+ * @return uint8_t 1 if the profile was accepted and stored, 0 otherwise
+ */
+uint8_t joystick_cal_finish(void);
+
+/**
+ * @brief Normalize a raw X-axis sample
+ *
+ * Passes the value through unchanged when calibration is inactive.
+ *
+ * @param raw Raw 8-bit sample
+ * @return uint8_t Normalized value (0-255, center at 128)
+ */
+uint8_t joystick_cal_apply_x(uint8_t raw);
+
+/**
+ * @brief Normalize a raw Y-axis sample
+ *
+ * Passes the value through unchanged when calibration is inactive.
+ *
+ * @param raw Raw 8-bit sample
+ * @return uint8_t Normalized value (0-255, center at 128)
+ */
+uint8_t joystick_cal_apply_y(uint8_t raw);
+
+#endif /* CALIBRATION_H */
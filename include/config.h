@@ -56,6 +56,18 @@
 #define DIAGONAL_THRESHOLD_HIGH 230     /**< High threshold for diagonals */
 #define DIAGONAL_THRESHOLD_LOW  50      /**< Low threshold for diagonals */
 
+/* Octant (polar) classifier dead zone: deflection from ADC_CENTER on
+ * both axes must reach this before a direction is reported */
+#define OCTANT_DEADZONE_RADIUS  40      /**< Max-norm dead-zone radius */
+
+/* Lookup-table classifier: the precomputed zone tables live in .bss,
+ * so their ~600 bytes of SRAM are reserved at link time whether or not
+ * joystick_lut_init() is ever called. Compiled out by default; enable
+ * only on builds with SRAM to spare. */
+#ifndef JOYSTICK_ENABLE_LUT
+#define JOYSTICK_ENABLE_LUT     0       /**< 1 = build the LUT classifier */
+#endif
+
 /*============================================================================
  * LCD Pin Configuration (8-bit mode)
  *============================================================================*/
@@ -66,23 +78,64 @@
 #define LCD_CTRL_PORT           PORTB   /**< Control port */
 #define LCD_CTRL_DDR            DDRB    /**< Control port direction */
 
-/* Data pins on PORTC */
+/* Data pins on PORTC. In 8-bit mode the whole port is used; in 4-bit
+ * mode only the upper nibble (D4-D7 on PC4-PC7) is driven, leaving
+ * PC0-PC3 free for other peripherals. */
 #define LCD_DATA_PORT           PORTC   /**< Data port */
 #define LCD_DATA_DDR            DDRC    /**< Data port direction */
+#define LCD_DATA_PIN            PINC    /**< Data port input register */
+
+/* Bus width: 0 = 8-bit (full data port), 1 = 4-bit (upper nibble only,
+ * nibbles sent back-to-back with busy-flag pacing) */
+#define LCD_USE_4BIT            0       /**< 1 = 4-bit bus mode */
+
+/* Busy-flag polling: wait only as long as the controller is actually
+ * busy (~40 us per write) instead of fixed millisecond delays.
+ * Requires the RW pin to be wired; set to 0 to fall back to delays. */
+#define LCD_USE_BUSY_FLAG       1       /**< 1 = poll busy flag, 0 = fixed delays */
 
-/* LCD timing (in milliseconds) */
+/* LCD timing (in milliseconds, used when busy-flag polling is off) */
 #define LCD_ENABLE_PULSE_MS     10      /**< Enable pulse width */
 #define LCD_COMMAND_DELAY_MS    10      /**< Delay after commands */
 
+/* LCD timing (in microseconds, used when busy-flag polling is on) */
+#define LCD_ENABLE_PULSE_US     2       /**< Enable pulse width (min 450 ns) */
+
 /*============================================================================
  * LCD Commands
  *============================================================================*/
 #define LCD_CMD_FUNCTION_SET    0x38    /**< 8-bit, 2 lines, 5x7 font */
+#define LCD_CMD_FUNCTION_SET_4BIT 0x28  /**< 4-bit, 2 lines, 5x7 font */
 #define LCD_CMD_DISPLAY_ON      0x0E    /**< Display on, cursor on */
 #define LCD_CMD_CLEAR           0x01    /**< Clear display */
 #define LCD_CMD_ENTRY_MODE      0x06    /**< Increment cursor, no shift */
 #define LCD_CMD_LINE1           0x80    /**< Start of line 1 */
 #define LCD_CMD_LINE2           0xC0    /**< Start of line 2 */
+#define LCD_CMD_SET_CGRAM       0x40    /**< Set CGRAM address (custom glyphs) */
+
+/*============================================================================
+ * UART Configuration
+ *============================================================================*/
+#define UART_BAUD               115200UL /**< Telemetry baud rate */
+
+/*============================================================================
+ * PWM Drive Stage
+ *============================================================================*/
+/* Zero-lag motor drive from the ADC sample hook (see pwm_drive.h).
+ * Its 256-byte transfer table is a link-time SRAM allocation, so the
+ * module is compiled out by default; motor builds enable it here. */
+#ifndef PWM_DRIVE_ENABLE
+#define PWM_DRIVE_ENABLE        0       /**< 1 = build the PWM drive stage */
+#endif
+
+/*============================================================================
+ * Performance Instrumentation
+ *============================================================================*/
+/* Timing probes around the hot paths (see perf.h). When 0, every probe
+ * compiles away to nothing; when 1, the perf module owns Timer0. */
+#ifndef PERF_ENABLE
+#define PERF_ENABLE             0       /**< 1 = build timing probes in */
+#endif
 
 /*============================================================================
  * General GPIO Configuration
@@ -0,0 +1,83 @@
+/**
+ * @file gesture.h
+ * @brief Velocity and Gesture Recognition over a Sample History Ring
+ *
+ * This module keeps a small power-of-two ring of timestamped joystick
+ * positions, maintains per-axis velocity incrementally as samples
+ * arrive (8.8 fixed point, O(1) per sample regardless of history
+ * depth), and recognizes flick, hold, and return-to-center gestures.
+ * Recognized gestures are emitted through the joystick event queue as
+ * JOYSTICK_EVENT_FLICK / _HOLD / _RETURN and drained with
+ * joystick_poll_event() like any other event.
+ */
+
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdint.h>
+#include "joystick.h"
+
+/** History ring depth; must be a power of two */
+#define GESTURE_HISTORY_SIZE        8
+
+/** EMA shift for the velocity estimate (smoothing = 1/2^shift) */
+#ifndef GESTURE_VELOCITY_SHIFT
+#define GESTURE_VELOCITY_SHIFT      2
+#endif
+
+/** Speed (counts/sample, 8.8 fixed point) that qualifies as a flick */
+#ifndef GESTURE_FLICK_THRESHOLD
+#define GESTURE_FLICK_THRESHOLD    (12 << 8)
+#endif
+
+/** Updates a direction must stay stable and slow to count as a hold */
+#ifndef GESTURE_HOLD_TICKS
+#define GESTURE_HOLD_TICKS          40
+#endif
+
+/**
+ * @brief Reset the gesture engine state
+ *
+ * Clears the history ring, velocity estimate, and recognizer state.
+ */
+void gesture_reset(void);
+
+/**
+ * @brief Feed one sample to the gesture engine
+ *
+ * Call once per sample period from the same context as
+ * joystick_event_update() (the event queue has a single producer).
+ * Reads the current position, appends it to the history ring, updates
+ * the incremental velocity estimate, and emits any recognized gestures
+ * through the joystick event queue.
+ *
+ * @param timestamp Caller-supplied timestamp (e.g. scheduler_ticks())
+ */
+void gesture_update(uint16_t timestamp);
+
+/**
+ * @brief Get the current X-axis velocity estimate
+ *
+ * @return int16_t Velocity in counts/sample, 8.8 fixed point
+ */
+int16_t gesture_velocity_x(void);
+
+/**
+ * @brief Get the current Y-axis velocity estimate
+ *
+ * @return int16_t Velocity in counts/sample, 8.8 fixed point
+ */
+int16_t gesture_velocity_y(void);
+
+/**
+ * @brief Look up a recent sample from the history ring
+ *
+ * @param age Samples back from the newest (0 = newest)
+ * @param pos Output; filled with the historical position
+ * @param timestamp Output; filled with the sample's timestamp
+ * @return uint8_t 1 if the slot holds a valid sample, 0 otherwise
+ */
+uint8_t gesture_history_get(uint8_t age, joystick_position_t *pos,
+                            uint16_t *timestamp);
+
+#endif /* GESTURE_H */
@@ -10,6 +10,7 @@
 #define JOYSTICK_H
 
 #include <stdint.h>
+#include "pgm_compat.h"
 
 /**
  * @brief Joystick direction enumeration
@@ -38,13 +39,130 @@ typedef struct {
     uint8_t y;          /**< Y-axis value (0-255) */
 } joystick_position_t;
 
+/**
+ * @brief Joystick event type
+ */
+typedef enum {
+    JOYSTICK_EVENT_PRESS = 0,   /**< Stick entered a non-center direction */
+    JOYSTICK_EVENT_RELEASE,     /**< Stick left a non-center direction */
+    JOYSTICK_EVENT_REPEAT,      /**< Direction held past the repeat interval */
+    JOYSTICK_EVENT_FLICK,       /**< Fast deflection (gesture engine) */
+    JOYSTICK_EVENT_HOLD,        /**< Steady deflection (gesture engine) */
+    JOYSTICK_EVENT_RETURN       /**< Back to center (gesture engine) */
+} joystick_event_type_t;
+
+/**
+ * @brief Joystick direction event
+ */
+typedef struct {
+    joystick_direction_t direction; /**< Direction the event refers to */
+    joystick_event_type_t type;     /**< Press, release or repeat */
+    uint16_t timestamp;             /**< Caller-supplied time of the event */
+} joystick_event_t;
+
+/** Event queue depth; must be a power of two */
+#define JOYSTICK_EVENT_QUEUE_SIZE   8
+
+/** Updates a direction must be held before repeat events fire
+ * (0 disables repeats); override before including to tune */
+#ifndef JOYSTICK_REPEAT_TICKS
+#define JOYSTICK_REPEAT_TICKS       50
+#endif
+
 /**
  * @brief Initialize the joystick interface
- * 
+ *
  * Configures ADC channels for X and Y axis reading.
  */
 void joystick_init(void);
 
+/**
+ * @brief Per-axis smoothing filter selection
+ */
+typedef enum {
+    JOYSTICK_FILTER_NONE = 0,   /**< Raw samples pass through */
+    JOYSTICK_FILTER_EMA,        /**< Exponential moving average */
+    JOYSTICK_FILTER_MEDIAN3,    /**< 3-tap median (spike rejection) */
+    JOYSTICK_FILTER_MEDIAN_EMA  /**< Median followed by EMA */
+} joystick_filter_mode_t;
+
+/**
+ * @brief Filter pipeline configuration
+ *
+ * The EMA smoothing factor is 1/2^ema_shift, so the filter is pure
+ * shifts and adds: shift 1 = heavy response, shift 3 = heavy smoothing.
+ */
+typedef struct {
+    joystick_filter_mode_t x_mode;  /**< Filter applied to the X axis */
+    joystick_filter_mode_t y_mode;  /**< Filter applied to the Y axis */
+    uint8_t x_ema_shift;            /**< X EMA shift (1-7), if EMA is used */
+    uint8_t y_ema_shift;            /**< Y EMA shift (1-7), if EMA is used */
+} joystick_filter_config_t;
+
+/**
+ * @brief Per-axis filter state: 8.8 EMA accumulator plus 3-sample history
+ *
+ * Internal to the filter pipeline; embedded in joystick_t so every
+ * instance smooths independently. Do not touch the fields directly.
+ */
+typedef struct {
+    uint16_t ema;       /**< 8.8 fixed-point accumulator */
+    uint8_t hist[3];    /**< recent samples for the median tap */
+    uint8_t hist_pos;   /**< next history slot to overwrite */
+    uint8_t primed;     /**< first sample seeds the state */
+} joystick_filter_state_t;
+
+/**
+ * @brief Configure the per-axis smoothing filters
+ *
+ * Filters run in 8.8 fixed point inside the position getters, after
+ * calibration remapping. Filter state is reset on every call. The
+ * default configuration is JOYSTICK_FILTER_NONE on both axes.
+ *
+ * @param config Filter configuration to apply
+ */
+void joystick_set_filter(const joystick_filter_config_t *config);
+
+/**
+ * @brief Sample the joystick and enqueue direction-change events
+ *
+ * Call at the sampling rate (e.g. from a scheduler tick or timer ISR).
+ * Classifies the current position and pushes press/release events on
+ * transitions, plus repeat events while a direction is held. The queue
+ * is single-producer/single-consumer and lock-free: this function is
+ * the only producer and joystick_poll_event() the only consumer, so
+ * either side may run in interrupt context. Events are dropped (newest
+ * first) if the queue is full.
+ *
+ * @param timestamp Caller-supplied timestamp stored in emitted events
+ *                  (e.g. scheduler_ticks())
+ */
+void joystick_event_update(uint16_t timestamp);
+
+/**
+ * @brief Enqueue a synthetic event
+ *
+ * Entry point for library extensions (e.g. the gesture engine) that
+ * emit through the same queue as joystick_event_update(). Must be
+ * called from the same context as joystick_event_update() to preserve
+ * the single-producer guarantee. The event is dropped if the queue is
+ * full.
+ *
+ * @param direction Direction the event refers to
+ * @param type Event type
+ * @param timestamp Timestamp stored in the event
+ */
+void joystick_event_emit(joystick_direction_t direction,
+                         joystick_event_type_t type, uint16_t timestamp);
+
+/**
+ * @brief Dequeue the oldest pending joystick event
+ *
+ * @param event Output; filled in when an event is available
+ * @return uint8_t 1 if an event was dequeued, 0 if the queue is empty
+ */
+uint8_t joystick_poll_event(joystick_event_t *event);
+
 /**
  * @brief Read current joystick position
  * 
@@ -66,26 +184,296 @@ uint8_t joystick_get_x(void);
  */
 uint8_t joystick_get_y(void);
 
+/**
+ * @brief Start publishing coherent position snapshots
+ *
+ * Hooks the ADC sample path and republishes each completed X/Y pair
+ * atomically under a sequence counter (seqlock). With the free-running
+ * scan, joystick_read() can otherwise pair an X from one conversion
+ * cycle with a Y from the next — a torn pair that shows up as phantom
+ * diagonals during fast motion. Snapshots guarantee both axes come
+ * from the same scan cycle. Chains to any sample hook already
+ * installed, so the PWM drive stage keeps working.
+ */
+void joystick_snapshot_enable(void);
+
+/**
+ * @brief Stop publishing snapshots and restore the previous sample hook
+ */
+void joystick_snapshot_disable(void);
+
+/**
+ * @brief Read the latest coherent {x, y, timestamp} snapshot
+ *
+ * Retries while the writer is mid-update (odd or changed sequence), so
+ * neither side ever disables interrupts and the sampling ISR's latency
+ * is unaffected. The position is raw (uncalibrated, unfiltered); run
+ * it through the usual pipeline if needed. The timestamp counts
+ * completed sample pairs since joystick_snapshot_enable() and wraps at
+ * 65535.
+ *
+ * @param pos Output position, both axes from the same scan cycle
+ * @param timestamp Optional output pair counter; pass NULL to skip
+ * @return uint8_t 1 on success, 0 if snapshots are disabled or no pair
+ *         has been published yet
+ */
+uint8_t joystick_read_snapshot(joystick_position_t *pos,
+                               uint16_t *timestamp);
+
+/**
+ * @brief One joystick instance
+ *
+ * The classic single-stick API above drives the channels named in
+ * config.h; consoles with more than one stick create a joystick_t per
+ * stick instead, each with its own channels, dead zone and filter
+ * state. Initialize with joystick_instance_init() and treat the
+ * contents as private afterwards.
+ */
+typedef struct {
+    uint8_t x_channel;              /**< ADC channel of the X axis */
+    uint8_t y_channel;              /**< ADC channel of the Y axis */
+    uint8_t center_x_min;           /**< Dead zone, X lower bound */
+    uint8_t center_x_max;           /**< Dead zone, X upper bound */
+    uint8_t center_y_min;           /**< Dead zone, Y lower bound */
+    uint8_t center_y_max;           /**< Dead zone, Y upper bound */
+    joystick_filter_config_t filter;    /**< Per-instance filter selection */
+    joystick_filter_state_t filter_x;   /**< X-axis filter state */
+    joystick_filter_state_t filter_y;   /**< Y-axis filter state */
+} joystick_t;
+
+/**
+ * @brief Initialize a joystick instance
+ *
+ * Binds the instance to its ADC channels and seeds the dead zone from
+ * the config.h center-zone bounds (override the center_* fields
+ * afterwards for sticks that need a different dead zone). Filters
+ * default to JOYSTICK_FILTER_NONE.
+ *
+ * @param js Instance to initialize
+ * @param x_channel ADC channel of the X axis (0-7)
+ * @param y_channel ADC channel of the Y axis (0-7)
+ */
+void joystick_instance_init(joystick_t *js, uint8_t x_channel,
+                            uint8_t y_channel);
+
+/**
+ * @brief Start one interleaved background scan over several instances
+ *
+ * Builds a single ADC scan sequence holding every instance's X and Y
+ * channels back to back, so all sticks refresh continuously at the
+ * conversion clock and reading any of them is a zero-wait memory
+ * access — total acquisition time for two sticks is the same as for
+ * one. Replaces any scan already running (including the one started
+ * by joystick_init()).
+ *
+ * @param sticks Array of instance pointers
+ * @param count Number of instances (2 * count channels must fit in
+ *        ADC_SCAN_MAX_CHANNELS)
+ * @return uint8_t 1 if the scan was started, 0 if count is unusable
+ */
+uint8_t joystick_scan_begin(joystick_t *const *sticks, uint8_t count);
+
+/**
+ * @brief Configure an instance's per-axis smoothing filters
+ *
+ * Instance counterpart of joystick_set_filter(); resets the instance's
+ * filter state.
+ *
+ * @param js Instance to configure
+ * @param config Filter configuration to apply
+ */
+void joystick_instance_set_filter(joystick_t *js,
+                                  const joystick_filter_config_t *config);
+
+/**
+ * @brief Read an instance's current position
+ *
+ * Serves the latest scanned samples (or blocking conversions when no
+ * scan is running) through the instance's filter pipeline. The stored
+ * calibration profile describes the primary stick's channels, so it is
+ * applied only to axes bound to JOYSTICK_X_CHANNEL/JOYSTICK_Y_CHANNEL;
+ * additional sticks pass through unmapped. Feed the result to
+ * joystick_get_direction() for classification — after calibration all
+ * sticks share the config.h threshold map.
+ *
+ * @param js Instance to read
+ * @param pos Output position
+ */
+void joystick_instance_read(joystick_t *js, joystick_position_t *pos);
+
+/**
+ * @brief Test a position against an instance's dead zone
+ *
+ * @param js Instance whose dead-zone bounds to use
+ * @param x X-axis value (0-255)
+ * @param y Y-axis value (0-255)
+ * @return uint8_t 1 if in the instance's center zone, 0 otherwise
+ */
+uint8_t joystick_instance_is_centered(const joystick_t *js, uint8_t x,
+                                      uint8_t y);
+
+/* Rate at which complete X/Y sample pairs arrive from the free-running
+ * two-channel scan with the ACCURATE ADC profile: 13 ADC clocks per
+ * conversion, two conversions per pair (~4.8 kHz at 16 MHz with the
+ * /128 prescaler). The burst engine switches to the FAST profile for
+ * the duration of a capture (restoring it on completion), so the
+ * achievable pair rates are 8x this figure; it queries
+ * adc_conversion_rate_hz() after switching. */
+#define JOYSTICK_BURST_PAIR_RATE_HZ \
+    ((uint16_t)(F_CPU / (128UL * 13UL * 2UL)))
+
+/**
+ * @brief Start a background burst capture into a caller-owned buffer
+ *
+ * Arms the free-running channel scan (if not already active) and fills
+ * buf with n calibrated X/Y pairs from the conversion-complete path,
+ * spaced by the ADC conversion clock rather than by loop timing. The
+ * requested rate is rounded to the nearest integer division of
+ * JOYSTICK_BURST_PAIR_RATE_HZ; pass 0 (or any higher rate) to capture
+ * every pair. Smoothing filters are bypassed so the record holds the
+ * unprocessed stick signal.
+ *
+ * The buffer must stay valid until joystick_burst_done() reports
+ * completion. Only one burst may be in flight at a time. If a sample
+ * hook is installed (e.g. the PWM drive stage) it keeps running during
+ * the capture and is restored afterwards.
+ *
+ * @param buf Destination array of at least n entries
+ * @param n Number of sample pairs to capture (nonzero)
+ * @param rate_hz Requested pair rate in Hz (0 = maximum)
+ * @return uint8_t 1 if the burst was armed, 0 on bad arguments or if a
+ *         burst is already in flight
+ */
+uint8_t joystick_burst_start(joystick_position_t *buf, uint16_t n,
+                             uint16_t rate_hz);
+
+/**
+ * @brief Check whether the in-flight burst has completed
+ *
+ * @return uint8_t 1 if no burst is in flight (buffer full), 0 otherwise
+ */
+uint8_t joystick_burst_done(void);
+
+/**
+ * @brief Capture a burst and block until the buffer is full
+ *
+ * Convenience wrapper around joystick_burst_start() that spins until
+ * completion. A 512-sample burst at the full FAST-profile pair rate
+ * takes ~13 ms; use the start/done pair to overlap that time with
+ * other work.
+ *
+ * @param buf Destination array of at least n entries
+ * @param n Number of sample pairs to capture (nonzero)
+ * @param rate_hz Requested pair rate in Hz (0 = maximum)
+ * @return uint8_t 1 on completion, 0 if the burst could not be armed
+ */
+uint8_t joystick_read_burst(joystick_position_t *buf, uint16_t n,
+                            uint16_t rate_hz);
+
+/* Maximum distinct threshold zones per axis for the lookup-table
+ * classifier (bounded by the number of comparisons in the cascade) */
+#define JOYSTICK_LUT_MAX_X_ZONES    8
+#define JOYSTICK_LUT_MAX_Y_ZONES    10
+
 /**
  * @brief Determine direction from X/Y values
- * 
+ *
  * Uses threshold-based zone detection to categorize the joystick
- * position into one of 9 directions.
- * 
+ * position into one of 9 directions. After joystick_lut_init() this
+ * runs branch-free in constant time via precomputed zone tables.
+ *
  * @param x X-axis value (0-255)
  * @param y Y-axis value (0-255)
  * @return joystick_direction_t Detected direction
  */
 joystick_direction_t joystick_get_direction(uint8_t x, uint8_t y);
 
+/**
+ * @brief Direction classifier selection
+ */
+typedef enum {
+    JOYSTICK_DIR_GRID = 0,  /**< Rectangular threshold zones (legacy) */
+    JOYSTICK_DIR_OCTANT     /**< Polar octants, no unclassifiable regions */
+} joystick_dir_mode_t;
+
+/**
+ * @brief Select the classifier used by joystick_get_direction()
+ *
+ * The default grid mode keeps the historical rectangular-zone
+ * behavior. Octant mode classifies by angle instead, so positions like
+ * (200, 200) that fall between the grid's diagonal and cardinal zones
+ * resolve to the nearest direction rather than dropping to DIR_CENTER.
+ *
+ * @param mode Classifier to use
+ */
+void joystick_set_direction_mode(joystick_dir_mode_t mode);
+
+/**
+ * @brief Classify a position into octants by angle
+ *
+ * Computes the deflection (dx, dy) from ADC_CENTER and derives the
+ * 45-degree octant from sign and magnitude comparisons: the
+ * 22.5-degree sector boundaries are tested against tan(22.5°) ~ 0.41,
+ * approximated with shifts — no atan2, no floats, no division.
+ * Constant cost (~20 cycles) and every position outside the
+ * OCTANT_DEADZONE_RADIUS dead zone maps to a direction; there are no
+ * dead wedges. Best used on calibrated positions, which are centered
+ * on ADC_CENTER by construction.
+ *
+ * @param x X-axis value (0-255)
+ * @param y Y-axis value (0-255)
+ * @return joystick_direction_t Detected direction
+ */
+joystick_direction_t joystick_get_direction_octant(uint8_t x, uint8_t y);
+
+/**
+ * @brief Build the lookup tables for branch-free direction detection
+ *
+ * Precomputes two 256-entry per-axis zone tables plus a small zone-pair
+ * combine table from the thresholds in config.h, reducing
+ * joystick_get_direction() to two loads and one table lookup with
+ * uniform timing. The tables cost about 600 bytes of SRAM and are
+ * reserved at link time, so they are compiled in only when
+ * JOYSTICK_ENABLE_LUT is set to 1 in config.h; with the option off
+ * (the default) this call is a no-op and the comparison cascade is
+ * used. Results are identical either way.
+ */
+void joystick_lut_init(void);
+
 /**
  * @brief Convert direction enum to string
- * 
+ *
  * @param dir Direction enumeration value
  * @return const char* Human-readable direction string (e.g., "N", "NE", "C")
  */
 const char* joystick_direction_to_string(joystick_direction_t dir);
 
+/**
+ * @brief Convert direction enum to a flash-resident string
+ *
+ * Returns a pointer into PROGMEM; print it with lcd_print_P() or read
+ * it with pgm_read_byte(). Unlike joystick_direction_to_string() this
+ * costs no SRAM copy.
+ *
+ * @param dir Direction enumeration value
+ * @return PGM_P Flash pointer to the direction string
+ */
+PGM_P joystick_direction_to_string_P(joystick_direction_t dir);
+
+/**
+ * @brief Sleep until the stick leaves the center dead zone
+ *
+ * Low-power watch mode for mostly-idle devices: the background scan is
+ * paused and both axes are converted one at a time with the CPU in ADC
+ * noise-reduction sleep, waking only per conversion to test against
+ * the CENTER_*_MIN/MAX dead zone. Returns (and resumes the background
+ * scan if it was running) as soon as either axis is deflected; one
+ * watch iteration is two conversions, so first-motion latency is a few
+ * hundred microseconds. The scheduler tick does not advance while
+ * watching. Global interrupts must be enabled.
+ */
+void joystick_wait_for_motion(void);
+
 /**
  * @brief Check if joystick is in center (dead) zone
  * 
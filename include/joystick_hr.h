@@ -0,0 +1,212 @@
+/**
+ * @file joystick_hr.h
+ * @brief High-Resolution (10-bit) Joystick Pipeline
+ *
+ * Parallel pipeline for applications that need the full 10-bit ADC
+ * resolution — proportional control near center, where 8-bit
+ * quantization (4 counts per step on the 10-bit scale) causes visible
+ * output stepping. Positions are carried as uint16_t on the 10-bit
+ * scale, thresholds are derived at compile time from the 8-bit values
+ * in config.h, and the filter and velocity stages run in 10.6 fixed
+ * point (6 fractional bits, the 10-bit counterpart of the 8-bit
+ * pipeline's 8.8 format).
+ *
+ * This module is additive: nothing in joystick.c calls into it, so
+ * applications on the 8-bit fast path pay no flash, SRAM, or cycles
+ * for it (none at all under the release profile's section GC). The
+ * two pipelines may run side by side; joystick_hr_to_position()
+ * bridges high-resolution samples into the existing classifier,
+ * gesture, and event machinery.
+ *
+ * Samples are acquired through adc_read_oversampled() with 16x
+ * oversampling, which yields 10 effective bits from clean 8-bit
+ * conversions — so the high-resolution path works under the FAST ADC
+ * profile and coexists with the free-running scan (paused and resumed
+ * around each read). One read costs 16 conversions per axis (~420 us
+ * for both axes at the FAST profile's 1 MHz ADC clock).
+ */
+
+#ifndef JOYSTICK_HR_H
+#define JOYSTICK_HR_H
+
+#include <stdint.h>
+#include "joystick.h"
+
+/* Oversampling exponent per axis read: 2^n conversions, n/2 extra
+ * bits. The default 4 (16 samples) extends 8-bit conversions to
+ * 10 effective bits; override before including to trade rate for
+ * resolution. */
+#ifndef JOYSTICK_HR_OVERSAMPLE_LOG2
+#define JOYSTICK_HR_OVERSAMPLE_LOG2 4
+#endif
+
+/* EMA shift for the 10.6 velocity estimate (smoothing = 1/2^shift) */
+#ifndef JOYSTICK_HR_VELOCITY_SHIFT
+#define JOYSTICK_HR_VELOCITY_SHIFT  2
+#endif
+
+/*============================================================================
+ * Compile-Time Threshold Scaling
+ *============================================================================*/
+/* An 8-bit value v covers the 10-bit interval [v * 4, v * 4 + 3], so
+ * a threshold used as a lower bound scales to v * 4 and one used as an
+ * upper bound to v * 4 + 3. Scaling this way makes the high-resolution
+ * classifier agree with the 8-bit cascade at every position — the
+ * config.h threshold map stays the single source of truth. */
+#define JOYSTICK_HR_SCALE(t)    ((uint16_t)((t) << 2))
+#define JOYSTICK_HR_SCALE_HI(t) ((uint16_t)(((t) << 2) | 3))
+
+#define ADC_HR_CENTER           JOYSTICK_HR_SCALE(ADC_CENTER)
+
+#define THRESHOLD_HR_NORTH_Y    JOYSTICK_HR_SCALE(THRESHOLD_NORTH_Y)
+#define THRESHOLD_HR_SOUTH_Y    JOYSTICK_HR_SCALE_HI(THRESHOLD_SOUTH_Y)
+#define THRESHOLD_HR_EAST_X     JOYSTICK_HR_SCALE(THRESHOLD_EAST_X)
+#define THRESHOLD_HR_WEST_X     JOYSTICK_HR_SCALE_HI(THRESHOLD_WEST_X)
+
+#define CENTER_HR_X_MIN         JOYSTICK_HR_SCALE(CENTER_X_MIN)
+#define CENTER_HR_X_MAX         JOYSTICK_HR_SCALE_HI(CENTER_X_MAX)
+#define CENTER_HR_Y_MIN         JOYSTICK_HR_SCALE(CENTER_Y_MIN)
+#define CENTER_HR_Y_MAX         JOYSTICK_HR_SCALE_HI(CENTER_Y_MAX)
+
+/*============================================================================
+ * 10.6 Fixed Point
+ *============================================================================*/
+/** Fractional bits carried by the filter and velocity stages */
+#define JOYSTICK_HR_FP_SHIFT    6
+
+/** Promote an integer count to 10.6 fixed point */
+#define JOYSTICK_HR_FP(v)       ((int16_t)((v) << JOYSTICK_HR_FP_SHIFT))
+
+/**
+ * @brief High-resolution joystick position
+ *
+ * Axis values on the 10-bit scale (0-1023); four times the 8-bit
+ * scale, so ADC_HR_CENTER is the rest position.
+ */
+typedef struct {
+    uint16_t x;         /**< X-axis value, 10-bit scale */
+    uint16_t y;         /**< Y-axis value, 10-bit scale */
+} joystick_hr_position_t;
+
+/**
+ * @brief Per-axis high-resolution filter state
+ *
+ * 10.6 EMA accumulator plus 3-sample history; the 10-bit counterpart
+ * of joystick_filter_state_t. Internal — do not touch the fields.
+ */
+typedef struct {
+    uint16_t ema;       /**< 10.6 fixed-point accumulator */
+    uint16_t hist[3];   /**< recent samples for the median tap */
+    uint8_t hist_pos;   /**< next history slot to overwrite */
+    uint8_t primed;     /**< first sample seeds the state */
+} joystick_hr_filter_state_t;
+
+/**
+ * @brief Reset the high-resolution pipeline state
+ *
+ * Clears the filter accumulators and the velocity estimate. Filter
+ * selection is kept.
+ */
+void joystick_hr_reset(void);
+
+/**
+ * @brief Configure the high-resolution per-axis smoothing filters
+ *
+ * Takes the same configuration as joystick_set_filter() — modes and
+ * EMA shifts mean the same thing, only the arithmetic runs in 10.6
+ * instead of 8.8. Filter state is reset on every call; the default is
+ * JOYSTICK_FILTER_NONE on both axes.
+ *
+ * @param config Filter configuration to apply
+ */
+void joystick_hr_set_filter(const joystick_filter_config_t *config);
+
+/**
+ * @brief Read the raw high-resolution position
+ *
+ * Oversampled acquisition on both axes, no filtering. Uncalibrated:
+ * the stored calibration profile maps 8-bit endpoints and would
+ * quantize away exactly the resolution this pipeline exists to keep.
+ *
+ * @param pos Output position, 10-bit scale
+ */
+void joystick_hr_read_raw(joystick_hr_position_t *pos);
+
+/**
+ * @brief Read the filtered high-resolution position
+ *
+ * joystick_hr_read_raw() followed by the configured per-axis filters
+ * (10.6 fixed point, shifts and adds only).
+ *
+ * @param pos Output position, 10-bit scale
+ */
+void joystick_hr_read(joystick_hr_position_t *pos);
+
+/**
+ * @brief Test a high-resolution position against the center dead zone
+ *
+ * Uses the compile-time scaled CENTER_HR_* bounds; agrees with
+ * joystick_is_centered() at every position.
+ *
+ * @param x X-axis value, 10-bit scale
+ * @param y Y-axis value, 10-bit scale
+ * @return uint8_t 1 if in the center zone, 0 otherwise
+ */
+uint8_t joystick_hr_is_centered(uint16_t x, uint16_t y);
+
+/**
+ * @brief Determine direction from a high-resolution position
+ *
+ * The threshold cascade on the 10-bit scale. By construction of the
+ * scaled thresholds this returns the same direction as
+ * joystick_get_direction(x >> 2, y >> 2) for every input; the value
+ * of the high-resolution path is the extra precision available to
+ * proportional consumers, not a different zone map.
+ *
+ * @param x X-axis value, 10-bit scale
+ * @param y Y-axis value, 10-bit scale
+ * @return joystick_direction_t Detected direction
+ */
+joystick_direction_t joystick_hr_get_direction(uint16_t x, uint16_t y);
+
+/**
+ * @brief Downscale a high-resolution position to the 8-bit scale
+ *
+ * Bridge into the existing 8-bit machinery (classifier LUT, gesture
+ * engine, event queue) for consumers that want high-resolution analog
+ * output but standard direction events.
+ *
+ * @param hr High-resolution position to convert
+ * @param pos Output 8-bit position
+ */
+void joystick_hr_to_position(const joystick_hr_position_t *hr,
+                             joystick_position_t *pos);
+
+/**
+ * @brief Feed one position to the 10.6 velocity tracker
+ *
+ * Call once per sample period with consecutive positions (raw or
+ * filtered). Updates the per-axis velocity EMA incrementally, like the
+ * gesture engine's estimator but in 10-bit counts and 10.6 fixed
+ * point. The gesture recognizer itself is resolution-independent and
+ * stays on the shared 8-bit path.
+ *
+ * @param pos Position sampled this period
+ */
+void joystick_hr_track(const joystick_hr_position_t *pos);
+
+/**
+ * @brief Get the current X-axis high-resolution velocity estimate
+ *
+ * @return int16_t Velocity in 10-bit counts/sample, 10.6 fixed point
+ */
+int16_t joystick_hr_velocity_x(void);
+
+/**
+ * @brief Get the current Y-axis high-resolution velocity estimate
+ *
+ * @return int16_t Velocity in 10-bit counts/sample, 10.6 fixed point
+ */
+int16_t joystick_hr_velocity_y(void);
+
+#endif /* JOYSTICK_HR_H */
@@ -10,6 +10,7 @@
 #define LCD_H
 
 #include <stdint.h>
+#include "pgm_compat.h"
 
 /**
  * @brief Initialize the LCD display
@@ -22,6 +23,40 @@
  */
 void lcd_init(void);
 
+/**
+ * @brief Begin asynchronous LCD initialization
+ *
+ * Nonblocking alternative to lcd_init() for startup-latency-critical
+ * builds: configures the pins and arms a state machine that walks the
+ * HD44780 init sequence as lcd_init_poll() is called, so the 100+ ms
+ * of controller power-up delays overlap with ADC warm-up and
+ * joystick_init() instead of stalling the whole device. Do not issue
+ * other LCD calls until lcd_init_done() reports completion.
+ */
+void lcd_init_start(void);
+
+/**
+ * @brief Advance the asynchronous init sequence
+ *
+ * Call repeatedly (e.g. once per scheduler tick or main-loop pass),
+ * passing the milliseconds elapsed since the previous call; the state
+ * machine issues the next init command once its delay has been waited
+ * out. Each poll costs microseconds in busy-flag builds; with
+ * LCD_USE_BUSY_FLAG off, the step that issues a command still pays
+ * that command's fixed write delay.
+ *
+ * @param elapsed_ms Milliseconds since the previous poll (0 allowed)
+ * @return uint8_t 1 once initialization has completed, 0 while pending
+ */
+uint8_t lcd_init_poll(uint8_t elapsed_ms);
+
+/**
+ * @brief Check whether asynchronous initialization has finished
+ *
+ * @return uint8_t 1 if the display is ready for use, 0 otherwise
+ */
+uint8_t lcd_init_done(void);
+
 /**
  * @brief Send a command byte to the LCD
  * 
@@ -58,18 +93,51 @@ void lcd_set_cursor(uint8_t row, uint8_t col);
  */
 void lcd_print(const char *str);
 
+/**
+ * @brief Print a flash-resident string at the current cursor position
+ *
+ * Use with PSTR() literals or joystick_direction_to_string_P() so the
+ * text stays in PROGMEM instead of occupying SRAM.
+ *
+ * @param str Null-terminated string in flash
+ */
+void lcd_print_P(PGM_P str);
+
 /**
  * @brief Print a character to the LCD at current cursor position
- * 
+ *
  * @param c Character to print
  */
 void lcd_putc(char c);
 
 /**
  * @brief Print an integer value to the LCD
- * 
+ *
  * @param value Integer value to print
  */
 void lcd_print_int(int16_t value);
 
+/**
+ * @brief Print an 8-bit value as exactly three decimal digits
+ *
+ * Fixed-width, zero-padded output ("007", "042", "255") written
+ * straight to lcd_data(); digits are extracted by repeated
+ * subtraction, so no libc itoa(), stack buffer or software division
+ * is involved. The constant width means repainting a value never
+ * requires clearing the old one.
+ *
+ * @param value Value to print (0-255)
+ */
+void lcd_print_u8_3(uint8_t value);
+
+/**
+ * @brief Print a 16-bit value as exactly five decimal digits
+ *
+ * Fixed-width, zero-padded counterpart of lcd_print_u8_3() for
+ * 16-bit values ("00000" to "65535"), also division-free.
+ *
+ * @param value Value to print (0-65535)
+ */
+void lcd_print_u16_5(uint16_t value);
+
 #endif /* LCD_H */
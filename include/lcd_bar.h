@@ -0,0 +1,67 @@
+/**
+ * @file lcd_bar.h
+ * @brief CGRAM Bargraph Widgets for Axis Visualization
+ *
+ * Horizontal bargraphs built from five custom partial-block glyphs
+ * (1-5 columns filled) programmed into the HD44780's CGRAM once at
+ * startup. A bar's fill is tracked in fifths of a cell, so an update
+ * rewrites only the cells whose glyph actually changed — typically the
+ * single boundary cell, i.e. one cursor command plus one data byte
+ * instead of repainting a 3-4 character numeric readout. That keeps a
+ * 50 Hz gauge well within the LCD's write budget.
+ *
+ * lcd_bar_setup() claims CGRAM character codes 0-4; text drawn through
+ * lcd_print() is unaffected (those codes are not printable characters).
+ */
+
+#ifndef LCD_BAR_H
+#define LCD_BAR_H
+
+#include <stdint.h>
+
+/**
+ * @brief One bargraph widget
+ *
+ * Initialize with lcd_bar_init(); treat the fields as private.
+ */
+typedef struct {
+    uint8_t row;        /**< LCD row the bar lives on */
+    uint8_t col;        /**< First cell of the bar */
+    uint8_t width;      /**< Bar length in cells */
+    uint8_t level;      /**< Current fill in fifths of a cell */
+} lcd_bar_t;
+
+/**
+ * @brief Program the partial-block glyphs into CGRAM
+ *
+ * Call once after the LCD is initialized, before any bar is drawn.
+ * Writes five glyphs (codes 0-4, filling 1-5 columns from the left).
+ */
+void lcd_bar_setup(void);
+
+/**
+ * @brief Bind a bar to a screen region and draw it empty
+ *
+ * Paints all width cells blank once; subsequent updates are
+ * incremental.
+ *
+ * @param bar Widget to initialize
+ * @param row LCD row (0 or 1)
+ * @param col First column of the bar
+ * @param width Bar length in cells (1-16)
+ */
+void lcd_bar_init(lcd_bar_t *bar, uint8_t row, uint8_t col, uint8_t width);
+
+/**
+ * @brief Set a bar's fill from an 8-bit value
+ *
+ * Scales value (0-255) onto the bar's width * 5 fill steps and
+ * rewrites only the cells whose glyph differs from the previous fill.
+ * A small change touches one cell; an unchanged value touches none.
+ *
+ * @param bar Widget to update
+ * @param value Fill amount (0 = empty, 255 = full)
+ */
+void lcd_bar_update(lcd_bar_t *bar, uint8_t value);
+
+#endif /* LCD_BAR_H */
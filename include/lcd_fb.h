@@ -0,0 +1,67 @@
+/**
+ * @file lcd_fb.h
+ * @brief Shadow Frame Buffer for HD44780 LCDs with Dirty-Cell Diffing
+ *
+ * This module layers a 16x2 character frame buffer over the LCD driver.
+ * Application code draws into the buffer at any rate; lcd_fb_flush()
+ * compares against the last frame sent to the panel and emits only the
+ * cells that changed, coalescing cursor moves for contiguous runs.
+ * An unchanged frame costs zero LCD bus traffic.
+ */
+
+#ifndef LCD_FB_H
+#define LCD_FB_H
+
+#include <stdint.h>
+
+/** Frame buffer dimensions (16x2 character LCD) */
+#define LCD_FB_ROWS             2
+#define LCD_FB_COLS             16
+
+/**
+ * @brief Initialize the frame buffer
+ *
+ * Fills both the pending and on-panel buffers with spaces and clears
+ * the display so the two start in sync. Call after lcd_init().
+ */
+void lcd_fb_init(void);
+
+/**
+ * @brief Fill the pending frame with spaces
+ *
+ * Unlike lcd_clear(), this touches only the shadow buffer; the panel
+ * is not updated until lcd_fb_flush().
+ */
+void lcd_fb_clear(void);
+
+/**
+ * @brief Write a formatted string into the pending frame
+ *
+ * Output is clipped at the right edge of the row; nothing wraps to the
+ * next line. The panel is not updated until lcd_fb_flush().
+ *
+ * @param row Row number (0 or 1)
+ * @param col Starting column (0-15)
+ * @param fmt printf-style format string
+ */
+void lcd_fb_printf(uint8_t row, uint8_t col, const char *fmt, ...);
+
+/**
+ * @brief Write a plain string into the pending frame
+ *
+ * @param row Row number (0 or 1)
+ * @param col Starting column (0-15)
+ * @param str Null-terminated string (clipped at the right edge)
+ */
+void lcd_fb_print(uint8_t row, uint8_t col, const char *str);
+
+/**
+ * @brief Send pending changes to the panel
+ *
+ * Diffs the pending frame against the last-flushed frame and writes
+ * only the changed cells, setting the cursor once per run of
+ * consecutive dirty cells.
+ */
+void lcd_fb_flush(void);
+
+#endif /* LCD_FB_H */
@@ -0,0 +1,111 @@
+/**
+ * @file perf.h
+ * @brief Hot-Path Timing Instrumentation
+ *
+ * Lightweight timing probes around the library's hot paths (the
+ * blocking ADC wait, direction classification and LCD transfers),
+ * aggregated into per-probe min/avg/max counters. Sections are timed
+ * with Timer0 free-running at F_CPU/8, so one tick is 0.5 us at 16 MHz
+ * and a probed section must complete within 127 us to avoid wrap.
+ *
+ * Build with PERF_ENABLE set to 1 in config.h (or on the compiler
+ * command line) to compile the probes in; when disabled every
+ * PERF_BEGIN/PERF_END expands to nothing and the module adds zero
+ * bytes of code or data.
+ *
+ * Each probe must be begun and ended from a single context (all
+ * foreground, or all inside one ISR), matching the single-producer
+ * discipline used elsewhere in the library; no locking is done.
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+#include "config.h"
+
+/* Probe identifiers */
+enum {
+    PERF_ID_ADC_WAIT = 0,   /**< Blocking wait on an ADC conversion */
+    PERF_ID_CLASSIFY,       /**< joystick_get_direction() */
+    PERF_ID_LCD_WRITE,      /**< One lcd_command()/lcd_data() transfer */
+    PERF_ID_COUNT
+};
+
+/** Start-of-frame marker for perf report frames on the telemetry UART */
+#define PERF_TELEMETRY_SYNC     0xA6
+
+/** Aggregated timing for one probe, in Timer0 ticks (0.5 us at 16 MHz) */
+typedef struct {
+    uint8_t min;            /**< Shortest section seen (0 if none) */
+    uint8_t avg;            /**< Mean section length */
+    uint8_t max;            /**< Longest section seen */
+    uint16_t count;         /**< Number of sections accumulated */
+} perf_stats_t;
+
+#if PERF_ENABLE
+
+/**
+ * @brief Start the probe timebase and clear all counters
+ *
+ * Takes ownership of Timer0 (free-running, F_CPU/8, no interrupt).
+ */
+void perf_init(void);
+
+/**
+ * @brief Open a timed section
+ *
+ * @param id Probe identifier (PERF_ID_*)
+ */
+void perf_begin(uint8_t id);
+
+/**
+ * @brief Close a timed section and fold it into the probe's counters
+ *
+ * @param id Probe identifier (PERF_ID_*)
+ */
+void perf_end(uint8_t id);
+
+/**
+ * @brief Clear one probe's counters
+ *
+ * @param id Probe identifier (PERF_ID_*)
+ */
+void perf_reset(uint8_t id);
+
+/**
+ * @brief Read one probe's aggregated statistics
+ *
+ * @param id Probe identifier (PERF_ID_*)
+ * @param stats Output; filled with min/avg/max and sample count
+ */
+void perf_get(uint8_t id, perf_stats_t *stats);
+
+/**
+ * @brief Render a probe's min/avg/max on LCD line 2
+ *
+ * Diagnostics overlay for field units: formats "lbl min/avg/max" (in
+ * Timer0 ticks) into the frame buffer's unused second row and flushes.
+ */
+void perf_report_lcd(uint8_t id);
+
+/**
+ * @brief Stream a probe's statistics over the telemetry UART
+ *
+ * Queues a 5-byte frame {PERF_TELEMETRY_SYNC, id, min, avg, max},
+ * all-or-nothing like the position telemetry frames.
+ */
+void perf_report_uart(uint8_t id);
+
+#define PERF_BEGIN(id)  perf_begin(id)
+#define PERF_END(id)    perf_end(id)
+
+#else /* !PERF_ENABLE */
+
+/* Instrumentation disabled: probes vanish entirely */
+#define PERF_BEGIN(id)  ((void)0)
+#define PERF_END(id)    ((void)0)
+
+#endif /* PERF_ENABLE */
+
+#endif /* PERF_H */
@@ -0,0 +1,38 @@
+/**
+ * @file pgm_compat.h
+ * @brief PROGMEM Compatibility Layer for AVR and Host Builds
+ *
+ * On AVR this pulls in <avr/pgmspace.h> so lookup tables and string
+ * literals can live in flash. On the host (the `make sim` build) the
+ * same macros degrade to plain memory accesses, letting the flash-aware
+ * code paths compile and run unchanged.
+ */
+
+#ifndef PGM_COMPAT_H
+#define PGM_COMPAT_H
+
+#ifdef __AVR__
+
+#include <avr/pgmspace.h>
+
+/* Older avr-libc lacks pgm_read_ptr; flash pointers are 16 bits */
+#ifndef pgm_read_ptr
+#define pgm_read_ptr(addr)      ((void *)pgm_read_word(addr))
+#endif
+
+#else /* host build */
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P                   const char *
+#define PSTR(s)                 (s)
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+#define pgm_read_ptr(addr)      (*(void *const *)(addr))
+#define strcpy_P                strcpy
+
+#endif /* __AVR__ */
+
+#endif /* PGM_COMPAT_H */
@@ -0,0 +1,76 @@
+/**
+ * @file pwm_drive.h
+ * @brief Zero-Lag PWM Drive Stage for Motor Output
+ *
+ * Maps joystick position straight to Timer1 PWM duty from the ADC
+ * conversion-complete path: each fresh axis sample is pushed through a
+ * precomputed transfer-curve table and written to OCR1A (X axis) or
+ * OCR1B (Y axis) inside the interrupt, bounding stick-to-PWM latency
+ * to one ADC conversion (~100 us) regardless of what the foreground
+ * loop is doing.
+ *
+ * Timer1 ownership: this module configures Timer1 for 8-bit fast PWM,
+ * so it cannot be used together with the scheduler module (which runs
+ * Timer1 in CTC mode). Motor pendants use the drive stage; display
+ * panels use the scheduler.
+ *
+ * The transfer table alone is 256 bytes of SRAM reserved at link time,
+ * so the module is compiled in only when PWM_DRIVE_ENABLE is set to 1
+ * in config.h; display-only builds pay nothing for it. Calling any of
+ * these functions with the option off fails at link.
+ */
+
+#ifndef PWM_DRIVE_H
+#define PWM_DRIVE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Transfer curve shape
+ */
+typedef enum {
+    PWM_CURVE_LINEAR = 0,   /**< Duty proportional to deflection */
+    PWM_CURVE_EXPO          /**< Soft around center, steep at the ends */
+} pwm_curve_t;
+
+/**
+ * @brief Initialize the drive stage and hook the ADC sample path
+ *
+ * Builds a 256-entry position-to-duty table for the chosen curve,
+ * configures Timer1 for 8-bit fast PWM on OC1A/OC1B (PD5/PD4), and
+ * installs the ADC sample hook. Duty is the curve of the absolute
+ * deflection from center, so both directions of travel map to
+ * 0-254; drive direction (H-bridge DIR pins) remains the
+ * application's responsibility via joystick_get_x()/get_y().
+ *
+ * Requires the free-running channel scan (started by joystick_init())
+ * to be active for samples to arrive.
+ *
+ * @param curve Transfer curve shape
+ * @param expo_strength Expo blend amount, 0 (linear) to 255 (full
+ *                      cubic); ignored for PWM_CURVE_LINEAR
+ */
+void pwm_drive_init(pwm_curve_t curve, uint8_t expo_strength);
+
+/**
+ * @brief Detach the drive stage and stop Timer1 PWM
+ *
+ * Removes the ADC sample hook and releases the OC1A/OC1B pins.
+ */
+void pwm_drive_stop(void);
+
+/**
+ * @brief Get the duty last written for the X axis
+ *
+ * @return uint8_t PWM duty (0-254)
+ */
+uint8_t pwm_drive_duty_x(void);
+
+/**
+ * @brief Get the duty last written for the Y axis
+ *
+ * @return uint8_t PWM duty (0-254)
+ */
+uint8_t pwm_drive_duty_y(void);
+
+#endif /* PWM_DRIVE_H */
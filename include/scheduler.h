@@ -0,0 +1,83 @@
+/**
+ * @file scheduler.h
+ * @brief Timer1 CTC Sampling Scheduler with Idle Sleep
+ *
+ * This module provides a fixed-rate tick generator built on Timer1 in
+ * CTC mode. Registered callbacks run from the main context on every
+ * tick, and the CPU sleeps in idle mode between ticks. This gives
+ * deterministic sample spacing (no _delay_ms() jitter) and cuts power
+ * draw while waiting.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+/** Maximum number of registered tick callbacks */
+#define SCHEDULER_MAX_TASKS     4
+
+/** Tick callback signature; runs from main context, not the ISR */
+typedef void (*scheduler_callback_t)(void);
+
+/**
+ * @brief Initialize the tick timer
+ *
+ * Configures Timer1 in CTC mode with a /64 prescaler to fire at the
+ * requested rate. Usable rates at 16 MHz range from about 4 Hz up to
+ * several kHz. Global interrupts must be enabled (sei()) for ticks
+ * to fire.
+ *
+ * @param rate_hz Tick frequency in Hz (e.g. 200)
+ */
+void scheduler_init(uint16_t rate_hz);
+
+/**
+ * @brief Register a callback to run every tick
+ *
+ * Callbacks run in registration order from scheduler_run().
+ * Equivalent to scheduler_add_periodic() with a period of 1.
+ *
+ * @param callback Function to call on each tick
+ * @return uint8_t 1 on success, 0 if the task table is full
+ */
+uint8_t scheduler_add(scheduler_callback_t callback);
+
+/**
+ * @brief Register a callback to run every period_ticks ticks
+ *
+ * Lets tasks with different natural rates share one tick: e.g. with a
+ * 500 Hz tick, a sampling task at period 1 and an LCD repaint task at
+ * period 50 (10 Hz) run side by side instead of both being locked to
+ * one delay constant. Tasks are cooperative and run to completion;
+ * keep each one shorter than a tick interval.
+ *
+ * @param callback Function to call when the period elapses
+ * @param period_ticks Ticks between runs (nonzero)
+ * @return uint8_t 1 on success, 0 if the task table is full or
+ *         period_ticks is 0
+ */
+uint8_t scheduler_add_periodic(scheduler_callback_t callback,
+                               uint16_t period_ticks);
+
+/**
+ * @brief Get the number of ticks since scheduler_init()
+ *
+ * Wraps at 65535. Read is atomic with respect to the tick interrupt.
+ *
+ * @return uint16_t Tick count
+ */
+uint16_t scheduler_ticks(void);
+
+/**
+ * @brief Run the scheduler loop (does not return)
+ *
+ * Sleeps the CPU in idle mode until the next tick, then runs every
+ * task whose period has elapsed. Idle sleep keeps Timer1 and the ADC
+ * running, so background channel scanning continues while asleep.
+ * The watchdog is serviced once per tick, after all due tasks have
+ * completed, giving the WDT a deterministic service point.
+ */
+void scheduler_run(void);
+
+#endif /* SCHEDULER_H */
@@ -0,0 +1,78 @@
+/**
+ * @file uart.h
+ * @brief Interrupt-Driven UART Transmitter with Telemetry Framing
+ *
+ * This module provides a non-blocking UART transmit path fed from a
+ * ring buffer drained by the data-register-empty interrupt, plus a
+ * compact 4-byte binary telemetry frame for streaming joystick samples
+ * off-device. Nothing here blocks: writes that do not fit are dropped
+ * and reported to the caller.
+ *
+ * Telemetry frame layout (4 bytes):
+ *   [0] sync byte (UART_TELEMETRY_SYNC)
+ *   [1] x-axis sample
+ *   [2] y-axis sample
+ *   [3] flags in the high nibble, direction in the low nibble
+ */
+
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+
+/** TX ring buffer depth; must be a power of two */
+#define UART_TX_BUFFER_SIZE     64
+
+/** Start-of-frame marker for telemetry frames */
+#define UART_TELEMETRY_SYNC     0xA5
+
+/**
+ * @brief Initialize the UART transmitter
+ *
+ * Configures 8N1 at UART_BAUD (config.h) with the double-speed bit set
+ * for low baud-rate error at 115200/16 MHz. Global interrupts must be
+ * enabled (sei()) for queued bytes to drain.
+ */
+void uart_init(void);
+
+/**
+ * @brief Queue one byte for transmission
+ *
+ * @param byte Byte to send
+ * @return uint8_t 1 if queued, 0 if the buffer was full (byte dropped)
+ */
+uint8_t uart_write_byte(uint8_t byte);
+
+/**
+ * @brief Queue a block of bytes for transmission
+ *
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return uint8_t Number of bytes actually queued
+ */
+uint8_t uart_write(const uint8_t *data, uint8_t len);
+
+/**
+ * @brief Get free space in the TX buffer
+ *
+ * @return uint8_t Number of bytes that can be queued without dropping
+ */
+uint8_t uart_tx_free(void);
+
+/**
+ * @brief Queue one telemetry frame
+ *
+ * Frames are all-or-nothing: if fewer than 4 bytes of buffer space
+ * remain the frame is dropped whole, so the receiver never sees a
+ * torn frame.
+ *
+ * @param x X-axis sample
+ * @param y Y-axis sample
+ * @param direction Direction code (0-8, low nibble)
+ * @param flags Event flags (0-15, high nibble)
+ * @return uint8_t 1 if the frame was queued, 0 if dropped
+ */
+uint8_t uart_send_telemetry(uint8_t x, uint8_t y, uint8_t direction,
+                            uint8_t flags);
+
+#endif /* UART_H */
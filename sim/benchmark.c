@@ -0,0 +1,670 @@
+/**
+ * @file benchmark.c
+ * @brief Host-Side Benchmark Harness for the Joystick Hot Paths
+ *
+ * Compiles src/joystick.c for the host (build via `make sim`), stubs
+ * the ADC and calibration hardware underneath it, and:
+ *   - verifies the lookup-table classifier against the threshold
+ *     cascade for all 65536 (x, y) inputs,
+ *   - sweeps every input through joystick_get_direction() with and
+ *     without the lookup tables and reports cycles/call (rdtsc on
+ *     x86, wall-clock nanoseconds elsewhere),
+ *   - runs the filter pipeline over a synthetic noisy trace as a
+ *     smoke test of the fixed-point math.
+ *
+ * Exits nonzero on any mismatch, so this doubles as the regression
+ * gate for hot-path changes.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../include/config.h"
+#include "../include/adc.h"
+#include "../include/calibration.h"
+#include "../include/joystick.h"
+#include "../include/joystick_hr.h"
+#include "../include/gesture.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES_AVAILABLE 1
+#else
+#define CYCLES_AVAILABLE 0
+#endif
+
+/*============================================================================
+ * Hardware stubs: joystick.c links against these instead of the AVR
+ * peripherals. Samples come from settable variables.
+ *============================================================================*/
+
+static uint8_t stub_samples[8];
+
+static adc_profile_t stub_profile = ADC_PROFILE_ACCURATE;
+
+void adc_init(void)
+{
+    stub_profile = ADC_PROFILE_ACCURATE;  /* mirrors the real driver */
+}
+
+void adc_scan_start(const uint8_t *channels, uint8_t count)
+{
+    (void)channels;
+    (void)count;
+}
+
+void adc_stop_freerun(void) {}
+
+void adc_scan_resume(void) {}
+
+void adc_set_profile(adc_profile_t profile)
+{
+    stub_profile = profile;
+}
+
+adc_profile_t adc_get_profile(void)
+{
+    return stub_profile;
+}
+
+uint32_t adc_conversion_rate_hz(void)
+{
+    return F_CPU /
+        (((stub_profile == ADC_PROFILE_FAST) ? 16UL : 128UL) * 13UL);
+}
+
+uint8_t adc_freerun_active(void)
+{
+    return 1;  /* always serve reads from stub_samples */
+}
+
+uint8_t adc_sleep_convert(uint8_t channel)
+{
+    return stub_samples[channel & 0x07];
+}
+
+uint8_t adc_latest(uint8_t channel)
+{
+    return stub_samples[channel & 0x07];
+}
+
+uint8_t adc_read_8bit(uint8_t channel)
+{
+    return stub_samples[channel & 0x07];
+}
+
+static uint16_t stub_hr_samples[8];
+
+uint16_t adc_read_oversampled(uint8_t channel, uint8_t log2_samples)
+{
+    (void)log2_samples;
+    return stub_hr_samples[channel & 0x07];
+}
+
+static adc_sample_hook_t stub_hook;
+
+adc_sample_hook_t adc_set_sample_hook(adc_sample_hook_t hook)
+{
+    adc_sample_hook_t previous = stub_hook;
+
+    stub_hook = hook;
+    return previous;
+}
+
+uint8_t joystick_cal_load(void)
+{
+    return 0;  /* no stored profile on the host */
+}
+
+uint8_t joystick_cal_apply_x(uint8_t raw)
+{
+    return raw;
+}
+
+uint8_t joystick_cal_apply_y(uint8_t raw)
+{
+    return raw;
+}
+
+/*============================================================================
+ * Timing helpers
+ *============================================================================*/
+
+static uint64_t timestamp(void)
+{
+#if CYCLES_AVAILABLE
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static const char *timestamp_unit(void)
+{
+    return CYCLES_AVAILABLE ? "cycles" : "ns";
+}
+
+/*============================================================================
+ * Benchmark and verification passes
+ *============================================================================*/
+
+/* Accumulator defeating dead-code elimination of the measured calls */
+static volatile uint32_t sink;
+
+/**
+ * @brief Sweep all 65536 inputs through joystick_get_direction()
+ */
+static double sweep_all(void)
+{
+    uint64_t start, elapsed;
+    unsigned x, y;
+
+    start = timestamp();
+    for (x = 0; x < 256; x++) {
+        for (y = 0; y < 256; y++) {
+            sink += joystick_get_direction((uint8_t)x, (uint8_t)y);
+        }
+    }
+    elapsed = timestamp() - start;
+
+    return (double)elapsed / 65536.0;
+}
+
+/**
+ * @brief Record the cascade's answer for every input
+ */
+static void snapshot_directions(uint8_t table[256][256])
+{
+    unsigned x, y;
+
+    for (x = 0; x < 256; x++) {
+        for (y = 0; y < 256; y++) {
+            table[x][y] = (uint8_t)joystick_get_direction((uint8_t)x,
+                                                          (uint8_t)y);
+        }
+    }
+}
+
+/**
+ * @brief Filter smoke test: a spike train through median+EMA must stay
+ *        near the baseline
+ */
+static int filter_smoke_test(void)
+{
+    joystick_filter_config_t cfg = {
+        JOYSTICK_FILTER_MEDIAN_EMA, JOYSTICK_FILTER_MEDIAN_EMA, 2, 2
+    };
+    unsigned i;
+    uint8_t value = 0;
+
+    joystick_set_filter(&cfg);
+
+    /* Settle at the baseline, then inject isolated full-scale spikes */
+    for (i = 0; i < 64; i++) {
+        stub_samples[0] = 128;
+        stub_samples[1] = 128;
+        value = joystick_get_x();
+        (void)joystick_get_y();
+    }
+    for (i = 0; i < 64; i++) {
+        stub_samples[0] = (i % 8 == 0) ? 255 : 128;
+        value = joystick_get_x();
+        if (value < 120 || value > 140) {
+            fprintf(stderr, "FAIL: filtered spike escaped (value %u)\n",
+                    value);
+            return 1;
+        }
+    }
+
+    /* Back to pass-through for any later passes */
+    cfg.x_mode = JOYSTICK_FILTER_NONE;
+    cfg.y_mode = JOYSTICK_FILTER_NONE;
+    joystick_set_filter(&cfg);
+
+    return 0;
+}
+
+/**
+ * @brief Gesture engine smoke test: deflect fast, hold, release
+ */
+static int gesture_smoke_test(void)
+{
+    joystick_event_t event;
+    uint16_t t = 0;
+    unsigned i;
+    int saw_flick = 0, saw_hold = 0, saw_return = 0;
+
+    gesture_reset();
+    stub_samples[0] = 128;
+    stub_samples[1] = 135;
+
+    /* Settle at center */
+    for (i = 0; i < 16; i++) {
+        gesture_update(t++);
+        while (joystick_poll_event(&event));
+    }
+
+    /* Fast deflection to full east, then hold it */
+    stub_samples[0] = 255;
+    for (i = 0; i < 64; i++) {
+        gesture_update(t++);
+        while (joystick_poll_event(&event)) {
+            if (event.type == JOYSTICK_EVENT_FLICK) saw_flick = 1;
+            if (event.type == JOYSTICK_EVENT_HOLD)  saw_hold = 1;
+        }
+    }
+
+    /* Release back to center */
+    stub_samples[0] = 128;
+    for (i = 0; i < 16; i++) {
+        gesture_update(t++);
+        while (joystick_poll_event(&event)) {
+            if (event.type == JOYSTICK_EVENT_RETURN) saw_return = 1;
+        }
+    }
+
+    if (!saw_flick || !saw_hold || !saw_return) {
+        fprintf(stderr, "FAIL: gesture events missing (flick %d hold %d "
+                "return %d)\n", saw_flick, saw_hold, saw_return);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Burst capture smoke test: drive the installed sample hook like
+ *        the conversion ISR would and check fill order and decimation
+ */
+static int burst_smoke_test(void)
+{
+    joystick_position_t buf[16];
+    unsigned pairs = 0;
+    uint8_t v = 0;
+
+    if (!joystick_burst_start(buf, 16, JOYSTICK_BURST_PAIR_RATE_HZ / 2) ||
+        stub_hook == NULL) {
+        fprintf(stderr, "FAIL: burst did not arm\n");
+        return 1;
+    }
+
+    /* The capture window runs on the fast ADC clock */
+    if (adc_get_profile() != ADC_PROFILE_FAST) {
+        fprintf(stderr, "FAIL: burst did not raise the ADC profile\n");
+        return 1;
+    }
+
+    /* Emulate the scan ISR: alternating X/Y samples with a ramp */
+    while (!joystick_burst_done()) {
+        stub_hook(JOYSTICK_X_CHANNEL, v);
+        stub_hook(JOYSTICK_Y_CHANNEL, (uint8_t)(v + 1));
+        v += 2;
+        if (++pairs > 1000) {
+            fprintf(stderr, "FAIL: burst never completed\n");
+            return 1;
+        }
+    }
+
+    /* Half the ACCURATE pair rate against the FAST-profile stream is a
+     * decimation of 16: every 16th pair is stored */
+    if (pairs != 256 || stub_hook != NULL ||
+        buf[0].x != 30 || buf[0].y != 31 || buf[1].x != 62 || buf[1].y != 63) {
+        fprintf(stderr, "FAIL: burst contents wrong (pairs %u, "
+                "buf[0] %u/%u, buf[1] %u/%u)\n", pairs,
+                buf[0].x, buf[0].y, buf[1].x, buf[1].y);
+        return 1;
+    }
+
+    /* Completion must hand back both the hook and the profile */
+    if (adc_get_profile() != ADC_PROFILE_ACCURATE) {
+        fprintf(stderr, "FAIL: burst did not restore the ADC profile\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Dual-instance smoke test: two sticks on separate channels must
+ *        read independently through their own filter state
+ */
+static int dual_instance_smoke_test(void)
+{
+    joystick_t left, right;
+    joystick_t *sticks[2] = { &left, &right };
+    joystick_filter_config_t cfg = {
+        JOYSTICK_FILTER_EMA, JOYSTICK_FILTER_EMA, 2, 2
+    };
+    joystick_position_t lpos, rpos;
+    unsigned i;
+
+    joystick_instance_init(&left, 0, 1);
+    joystick_instance_init(&right, 2, 3);
+    joystick_instance_set_filter(&right, &cfg);
+
+    /* Starting a multi-stick scan must not reset the active profile */
+    adc_set_profile(ADC_PROFILE_FAST);
+    if (!joystick_scan_begin(sticks, 2)) {
+        fprintf(stderr, "FAIL: dual scan did not start\n");
+        return 1;
+    }
+    if (adc_get_profile() != ADC_PROFILE_FAST) {
+        fprintf(stderr, "FAIL: scan begin reset the ADC profile\n");
+        return 1;
+    }
+    adc_set_profile(ADC_PROFILE_ACCURATE);
+
+    stub_samples[0] = 10;
+    stub_samples[1] = 20;
+    stub_samples[2] = 200;
+    stub_samples[3] = 210;
+
+    /* Let the right stick's EMA converge */
+    for (i = 0; i < 64; i++) {
+        joystick_instance_read(&left, &lpos);
+        joystick_instance_read(&right, &rpos);
+    }
+
+    if (lpos.x != 10 || lpos.y != 20 ||
+        rpos.x < 198 || rpos.x > 202 || rpos.y < 208 || rpos.y > 212) {
+        fprintf(stderr, "FAIL: instance reads wrong (left %u/%u, "
+                "right %u/%u)\n", lpos.x, lpos.y, rpos.x, rpos.y);
+        return 1;
+    }
+
+    if (joystick_instance_is_centered(&right, rpos.x, rpos.y) ||
+        !joystick_instance_is_centered(&left, 128, 128)) {
+        fprintf(stderr, "FAIL: instance dead zone wrong\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Octant classifier check: exhaustive comparison against a
+ *        floating-point atan2 reference, with slack only at the
+ *        approximated 22.5-degree boundaries
+ */
+static int octant_test(void)
+{
+    static const joystick_direction_t sector[8] = {
+        DIR_EAST, DIR_NORTH_EAST, DIR_NORTH, DIR_NORTH_WEST,
+        DIR_WEST, DIR_SOUTH_WEST, DIR_SOUTH, DIR_SOUTH_EAST
+    };
+    unsigned x, y;
+    uint32_t checked = 0;
+
+    joystick_set_direction_mode(JOYSTICK_DIR_OCTANT);
+
+    for (x = 0; x < 256; x++) {
+        for (y = 0; y < 256; y++) {
+            int dx = (int)x - 128;
+            int dy = (int)y - 128;
+            int ax = abs(dx), ay = abs(dy);
+            joystick_direction_t dir =
+                joystick_get_direction((uint8_t)x, (uint8_t)y);
+            double angle, boundary_dist;
+            int idx;
+
+            if (ax < 40 && ay < 40) {
+                if (dir != DIR_CENTER) {
+                    fprintf(stderr, "FAIL: octant dead zone broken at "
+                            "%u/%u\n", x, y);
+                    return 1;
+                }
+                continue;
+            }
+
+            /* No dead wedges outside the dead zone */
+            if (dir == DIR_CENTER) {
+                fprintf(stderr, "FAIL: octant dead wedge at %u/%u\n", x, y);
+                return 1;
+            }
+
+            /* Exact agreement required away from sector boundaries,
+             * which sit at +/-22.5 + k*45 degrees */
+            angle = atan2((double)dy, (double)dx) *
+                    (180.0 / 3.14159265358979323846);
+            boundary_dist = fabs(fmod(fabs(angle), 45.0) - 22.5);
+
+            idx = (int)floor((angle + 22.5) / 45.0);
+            idx = ((idx % 8) + 8) % 8;
+
+            if (boundary_dist > 3.0 && dir != sector[idx]) {
+                fprintf(stderr, "FAIL: octant mismatch at %u/%u "
+                        "(angle %.1f, got %d want %d)\n",
+                        x, y, angle, dir, sector[idx]);
+                return 1;
+            }
+            checked++;
+        }
+    }
+
+    joystick_set_direction_mode(JOYSTICK_DIR_GRID);
+
+    printf("octant classifier: %lu positions verified against atan2\n",
+           (unsigned long)checked);
+    return 0;
+}
+
+/**
+ * @brief Seqlock snapshot test: a half-delivered pair must never leak
+ *        into a read
+ */
+static int snapshot_smoke_test(void)
+{
+    joystick_position_t pos;
+    uint16_t stamp = 0;
+
+    joystick_snapshot_enable();
+    if (stub_hook == NULL) {
+        fprintf(stderr, "FAIL: snapshot hook not installed\n");
+        return 1;
+    }
+
+    /* Nothing published yet */
+    if (joystick_read_snapshot(&pos, &stamp) != 0) {
+        fprintf(stderr, "FAIL: snapshot before first pair\n");
+        return 1;
+    }
+
+    /* One complete pair, then a dangling X from the next cycle: the
+     * read must return the complete pair, not the newer torn one */
+    stub_hook(JOYSTICK_X_CHANNEL, 10);
+    stub_hook(JOYSTICK_Y_CHANNEL, 20);
+    stub_hook(JOYSTICK_X_CHANNEL, 99);
+
+    if (!joystick_read_snapshot(&pos, &stamp) ||
+        pos.x != 10 || pos.y != 20 || stamp != 1) {
+        fprintf(stderr, "FAIL: snapshot torn or stale (%u/%u stamp %u)\n",
+                pos.x, pos.y, stamp);
+        return 1;
+    }
+
+    /* The dangling X completes with the next Y */
+    stub_hook(JOYSTICK_Y_CHANNEL, 77);
+    if (!joystick_read_snapshot(&pos, &stamp) ||
+        pos.x != 99 || pos.y != 77 || stamp != 2) {
+        fprintf(stderr, "FAIL: snapshot not updated (%u/%u stamp %u)\n",
+                pos.x, pos.y, stamp);
+        return 1;
+    }
+
+    joystick_snapshot_disable();
+    if (stub_hook != NULL) {
+        fprintf(stderr, "FAIL: snapshot hook not restored\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/* High-resolution pipeline: the scaled-threshold classifier must agree
+ * with the 8-bit cascade at every position and every sub-LSB offset,
+ * and the 10.6 filter/velocity math must behave like its 8.8 twin. */
+static int hr_smoke_test(void)
+{
+    joystick_filter_config_t cfg;
+    joystick_hr_position_t hr;
+    joystick_position_t pos8;
+    unsigned x, y;
+    uint32_t verified = 0;
+    int i;
+
+    joystick_set_direction_mode(JOYSTICK_DIR_GRID);
+
+    for (x = 0; x < 256; x++) {
+        for (y = 0; y < 256; y++) {
+            joystick_direction_t ref =
+                joystick_get_direction((uint8_t)x, (uint8_t)y);
+
+            /* Offsets 0 and 3 bracket the 10-bit interval an 8-bit
+             * value covers */
+            if (joystick_hr_get_direction((uint16_t)((x << 2) | 0),
+                                          (uint16_t)((y << 2) | 0)) != ref ||
+                joystick_hr_get_direction((uint16_t)((x << 2) | 3),
+                                          (uint16_t)((y << 2) | 3)) != ref) {
+                fprintf(stderr, "FAIL: hr classifier disagrees at %u/%u\n",
+                        x, y);
+                return 1;
+            }
+            verified += 2;
+        }
+    }
+
+    /* Median+EMA in 10.6: a one-sample spike must not move the output,
+     * a sustained step must converge to the new level */
+    cfg.x_mode = JOYSTICK_FILTER_MEDIAN_EMA;
+    cfg.y_mode = JOYSTICK_FILTER_NONE;
+    cfg.x_ema_shift = 3;
+    cfg.y_ema_shift = 3;
+    joystick_hr_set_filter(&cfg);
+
+    stub_hr_samples[JOYSTICK_X_CHANNEL] = 512;
+    stub_hr_samples[JOYSTICK_Y_CHANNEL] = 512;
+    joystick_hr_read(&hr);          /* primes the state at 512 */
+
+    stub_hr_samples[JOYSTICK_X_CHANNEL] = 1023;  /* spike */
+    joystick_hr_read(&hr);
+    stub_hr_samples[JOYSTICK_X_CHANNEL] = 512;
+    joystick_hr_read(&hr);
+    if (hr.x != 512) {
+        fprintf(stderr, "FAIL: hr median did not reject spike (%u)\n", hr.x);
+        return 1;
+    }
+
+    stub_hr_samples[JOYSTICK_X_CHANNEL] = 768;
+    for (i = 0; i < 100; i++) {
+        joystick_hr_read(&hr);
+    }
+    if (hr.x < 767 || hr.x > 768) {
+        fprintf(stderr, "FAIL: hr EMA did not converge (%u)\n", hr.x);
+        return 1;
+    }
+    if (hr.y != 512) {
+        fprintf(stderr, "FAIL: hr unfiltered axis altered (%u)\n", hr.y);
+        return 1;
+    }
+
+    joystick_hr_to_position(&hr, &pos8);
+    if (pos8.x != (uint8_t)(hr.x >> 2) || pos8.y != 512 >> 2) {
+        fprintf(stderr, "FAIL: hr downscale wrong (%u/%u)\n",
+                pos8.x, pos8.y);
+        return 1;
+    }
+
+    /* Velocity tracker: a steady +8 counts/sample ramp must settle at
+     * 8 in 10.6 fixed point */
+    joystick_hr_reset();
+    hr.x = 0;
+    hr.y = 512;
+    for (i = 0; i < 40; i++) {
+        joystick_hr_track(&hr);
+        hr.x = (uint16_t)(hr.x + 8);
+    }
+    if (joystick_hr_velocity_x() < JOYSTICK_HR_FP(8) - 8 ||
+        joystick_hr_velocity_x() > JOYSTICK_HR_FP(8) ||
+        joystick_hr_velocity_y() != 0) {
+        fprintf(stderr, "FAIL: hr velocity off (%d/%d)\n",
+                joystick_hr_velocity_x(), joystick_hr_velocity_y());
+        return 1;
+    }
+
+    printf("hr classifier: %lu scaled positions verified against "
+           "8-bit cascade\n", (unsigned long)verified);
+    return 0;
+}
+
+int main(void)
+{
+    static uint8_t cascade[256][256];
+    double cascade_cost, lut_cost;
+    unsigned x, y;
+    uint32_t mismatches = 0;
+
+    joystick_init();
+
+    /* Pass 1: threshold cascade */
+    cascade_cost = sweep_all();
+    snapshot_directions(cascade);
+
+    /* Pass 2: lookup tables, verified cell by cell */
+    joystick_lut_init();
+    lut_cost = sweep_all();
+
+    for (x = 0; x < 256; x++) {
+        for (y = 0; y < 256; y++) {
+            if (cascade[x][y] !=
+                (uint8_t)joystick_get_direction((uint8_t)x, (uint8_t)y)) {
+                mismatches++;
+            }
+        }
+    }
+
+    printf("joystick_get_direction, 65536-input sweep:\n");
+    printf("  cascade: %8.2f %s/call\n", cascade_cost, timestamp_unit());
+    printf("  lut:     %8.2f %s/call\n", lut_cost, timestamp_unit());
+    printf("  lut vs cascade mismatches: %lu\n", (unsigned long)mismatches);
+
+    if (mismatches != 0) {
+        fprintf(stderr, "FAIL: classifiers disagree\n");
+        return 1;
+    }
+
+    if (filter_smoke_test() != 0) {
+        return 1;
+    }
+
+    if (gesture_smoke_test() != 0) {
+        return 1;
+    }
+
+    if (burst_smoke_test() != 0) {
+        return 1;
+    }
+
+    if (dual_instance_smoke_test() != 0) {
+        return 1;
+    }
+
+    if (octant_test() != 0) {
+        return 1;
+    }
+
+    if (snapshot_smoke_test() != 0) {
+        return 1;
+    }
+
+    if (hr_smoke_test() != 0) {
+        return 1;
+    }
+
+    printf("sim benchmark passed\n");
+    return 0;
+}
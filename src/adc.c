@@ -4,9 +4,47 @@
  */
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
 #include <util/delay.h>
 #include "../include/config.h"
 #include "../include/adc.h"
+#include "../include/perf.h"
+
+/* ATmega16 calls the auto-trigger bit ADFR; newer parts call it ADATE.
+ * Both live at bit 5 of ADCSRA. */
+#ifndef ADFR
+#define ADFR ADATE
+#endif
+
+/* Number of single-ended ADC channels on the ATmega16/32 */
+#define ADC_NUM_CHANNELS        8
+
+/* Double-buffered sample registers filled by the conversion-complete ISR.
+ * adc_sample_sel[ch] indexes the slot holding the latest completed sample;
+ * the ISR writes the other slot and flips the selector, so a reader
+ * interrupted mid-access still sees a consistent value. */
+static volatile uint8_t adc_sample[ADC_NUM_CHANNELS][2];
+static volatile uint8_t adc_sample_sel[ADC_NUM_CHANNELS];
+
+/* Channel scan list cycled by the ISR in free-running mode. In free-running
+ * mode ADMUX is latched when a conversion starts, so the MUX value written
+ * in the ISR takes effect one conversion later than the result being read.
+ * adc_scan_result_pos tracks the list index whose result arrives at the
+ * next interrupt; adc_scan_mux_pos tracks the index last written to ADMUX. */
+static uint8_t adc_scan_list[ADC_SCAN_MAX_CHANNELS];
+static volatile uint8_t adc_scan_count;
+static volatile uint8_t adc_scan_result_pos;
+static volatile uint8_t adc_scan_mux_pos;
+
+/* Nonzero while the free-running engine owns the ADC */
+static volatile uint8_t adc_freerun_enabled;
+
+/* Optional per-sample callback run from the conversion-complete ISR */
+static adc_sample_hook_t adc_sample_hook;
+
+/* Acquisition profile last applied to the prescaler bits */
+static adc_profile_t adc_profile = ADC_PROFILE_ACCURATE;
 
 void adc_init(void)
 {
@@ -24,6 +62,37 @@ void adc_init(void)
      * - ADPS[2:0] = 111: Prescaler = 128 (for 16MHz -> 125kHz ADC clock)
      */
     ADCSRA = (1 << ADEN) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);
+    adc_profile = ADC_PROFILE_ACCURATE;
+}
+
+void adc_set_profile(adc_profile_t profile)
+{
+    uint8_t adcsra = ADCSRA &
+        (uint8_t)~((1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0));
+
+    if (profile == ADC_PROFILE_FAST) {
+        /* /16: 1 MHz ADC clock, clean for 8-bit conversions */
+        adcsra |= (1 << ADPS2);
+    } else {
+        /* /128: 125 kHz, inside the 50-200 kHz full-accuracy band */
+        adcsra |= (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);
+    }
+
+    ADCSRA = adcsra;
+    adc_profile = profile;
+}
+
+adc_profile_t adc_get_profile(void)
+{
+    return adc_profile;
+}
+
+uint32_t adc_conversion_rate_hz(void)
+{
+    uint8_t prescaler = (adc_profile == ADC_PROFILE_FAST) ? 16 : 128;
+
+    /* 13 ADC clocks per free-running conversion */
+    return F_CPU / ((uint32_t)prescaler * 13UL);
 }
 
 uint16_t adc_read(uint8_t channel)
@@ -36,10 +105,12 @@ uint16_t adc_read(uint8_t channel)
     
     /* Start conversion */
     ADCSRA |= (1 << ADSC);
-    
+
     /* Wait for conversion to complete */
+    PERF_BEGIN(PERF_ID_ADC_WAIT);
     while (ADCSRA & (1 << ADSC));
-    
+    PERF_END(PERF_ID_ADC_WAIT);
+
     /* Return 10-bit result */
     return ADC;
 }
@@ -54,10 +125,12 @@ uint8_t adc_read_8bit(uint8_t channel)
     
     /* Start conversion */
     ADCSRA |= (1 << ADSC);
-    
+
     /* Wait for conversion to complete */
+    PERF_BEGIN(PERF_ID_ADC_WAIT);
     while (ADCSRA & (1 << ADSC));
-    
+    PERF_END(PERF_ID_ADC_WAIT);
+
     /* Return upper 8 bits (ADCH) */
     return ADCH;
 }
@@ -67,3 +140,201 @@ uint8_t adc_to_percent(uint8_t value)
     /* Convert 0-255 to 0-100 */
     return (uint8_t)((uint16_t)value * 100 / 255);
 }
+
+uint8_t adc_sleep_convert(uint8_t channel)
+{
+    uint8_t ch = channel & 0x07;
+    uint8_t saved_ch, saved_count, result;
+
+    /* Let any conversion in flight drain first */
+    while (ADCSRA & (1 << ADSC));
+
+    /* Borrow the scan-list state (restored below) so a stopped scan
+     * can still be resumed with adc_scan_resume() afterwards */
+    saved_ch = adc_scan_list[0];
+    saved_count = adc_scan_count;
+
+    /* Point the ISR's single-entry scan state at this channel so the
+     * result lands in the right sample register */
+    adc_scan_list[0] = ch;
+    adc_scan_count = 1;
+    adc_scan_result_pos = 0;
+    adc_scan_mux_pos = 0;
+
+    ADMUX = (ADMUX & 0xF0) | (1 << ADLAR) | ch;
+
+    ADCSRA |= (1 << ADIF);   /* clear any stale flag */
+    ADCSRA |= (1 << ADIE);
+
+    /* Entering ADC noise-reduction sleep starts the conversion; the
+     * completion interrupt wakes us. Re-sleep if some other interrupt
+     * woke the CPU before the conversion finished. */
+    set_sleep_mode(SLEEP_MODE_ADC);
+    do {
+        sleep_mode();
+    } while (ADCSRA & (1 << ADSC));
+
+    ADCSRA &= ~(1 << ADIE);
+
+    result = adc_latest(ch);
+
+    adc_scan_list[0] = saved_ch;
+    adc_scan_count = saved_count;
+
+    return result;
+}
+
+uint16_t adc_read_oversampled(uint8_t channel, uint8_t log2_samples)
+{
+    uint16_t sum = 0;
+    uint16_t samples, i;
+    uint8_t resume = adc_freerun_enabled;
+
+    /* 256 samples of 8 bits is the most a 16-bit accumulator holds */
+    if (log2_samples > 8) {
+        log2_samples = 8;
+    }
+    samples = (uint16_t)1 << log2_samples;
+
+    /* Pause the scan engine and let any conversion in flight drain */
+    if (resume) {
+        adc_stop_freerun();
+        while (ADCSRA & (1 << ADSC));
+    }
+
+    /* Select channel, left-adjusted for 8-bit samples */
+    ADMUX = (ADMUX & 0xF0) | (1 << ADLAR) | (channel & 0x07);
+
+    /* Auto-trigger back-to-back conversions with interrupts off;
+     * completion is observed by polling ADIF */
+    ADCSRA |= (1 << ADFR);
+    ADCSRA |= (1 << ADIF);       /* clear any stale flag */
+    ADCSRA |= (1 << ADSC);
+
+    for (i = 0; i < samples; i++) {
+        while (!(ADCSRA & (1 << ADIF)));
+        sum += ADCH;
+        ADCSRA |= (1 << ADIF);   /* writing 1 clears the flag */
+    }
+
+    /* Back to single-conversion mode */
+    ADCSRA &= ~(1 << ADFR);
+
+    /* Resume the scan engine with its stored channel list */
+    if (resume) {
+        adc_scan_start(adc_scan_list, adc_scan_count);
+    }
+
+    /* Decimate: half the oversampling exponent becomes extra bits */
+    return sum >> (log2_samples >> 1);
+}
+
+void adc_start_freerun(uint8_t channel)
+{
+    uint8_t ch = channel & 0x07;
+
+    /* Single channel is just a one-entry scan */
+    adc_scan_start(&ch, 1);
+}
+
+void adc_scan_start(const uint8_t *channels, uint8_t count)
+{
+    uint8_t i;
+
+    if (count == 0) {
+        return;
+    }
+    if (count > ADC_SCAN_MAX_CHANNELS) {
+        count = ADC_SCAN_MAX_CHANNELS;
+    }
+
+    for (i = 0; i < count; i++) {
+        adc_scan_list[i] = channels[i] & 0x07;
+    }
+    adc_scan_count = count;
+    adc_scan_result_pos = 0;
+
+    /* Select first channel, left-adjusted for 8-bit samples */
+    ADMUX = (ADMUX & 0xF0) | (1 << ADLAR) | adc_scan_list[0];
+
+    /* Enable auto-trigger (free-running) and the conversion-complete
+     * interrupt, then kick off the first conversion */
+    adc_freerun_enabled = 1;
+    ADCSRA |= (1 << ADFR) | (1 << ADIE) | (1 << ADIF);
+    ADCSRA |= (1 << ADSC);
+
+    /* Conversion 0 has latched channel 0; pre-program ADMUX so
+     * conversion 1 samples the next channel in the list */
+    adc_scan_mux_pos = (count > 1) ? 1 : 0;
+    ADMUX = (ADMUX & 0xF0) | adc_scan_list[adc_scan_mux_pos];
+}
+
+void adc_stop_freerun(void)
+{
+    /* Disable auto-trigger and the interrupt; any conversion already in
+     * flight completes harmlessly with ADIE clear */
+    ADCSRA &= ~((1 << ADFR) | (1 << ADIE));
+    adc_freerun_enabled = 0;
+}
+
+void adc_scan_resume(void)
+{
+    if (adc_scan_count == 0) {
+        return;
+    }
+    adc_scan_start(adc_scan_list, adc_scan_count);
+}
+
+uint8_t adc_freerun_active(void)
+{
+    return adc_freerun_enabled;
+}
+
+uint8_t adc_latest(uint8_t channel)
+{
+    uint8_t ch = channel & 0x07;
+    return adc_sample[ch][adc_sample_sel[ch]];
+}
+
+adc_sample_hook_t adc_set_sample_hook(adc_sample_hook_t hook)
+{
+    adc_sample_hook_t previous = adc_sample_hook;
+
+    adc_sample_hook = hook;
+    return previous;
+}
+
+/**
+ * @brief ADC conversion-complete interrupt
+ *
+ * Deposits the fresh sample into the inactive buffer slot for its
+ * channel, publishes it by flipping the slot selector, then advances
+ * the scan sequence. ADMUX is programmed two steps ahead of the result
+ * position because the next conversion is already in flight when the
+ * interrupt fires.
+ */
+ISR(ADC_vect)
+{
+    uint8_t ch = adc_scan_list[adc_scan_result_pos];
+    uint8_t next = adc_sample_sel[ch] ^ 1;
+
+    adc_sample[ch][next] = ADCH;
+    adc_sample_sel[ch] = next;
+
+    if (adc_sample_hook) {
+        adc_sample_hook(ch, adc_sample[ch][next]);
+    }
+
+    if (adc_scan_count > 1) {
+        adc_scan_result_pos++;
+        if (adc_scan_result_pos == adc_scan_count) {
+            adc_scan_result_pos = 0;
+        }
+
+        adc_scan_mux_pos++;
+        if (adc_scan_mux_pos == adc_scan_count) {
+            adc_scan_mux_pos = 0;
+        }
+        ADMUX = (ADMUX & 0xF0) | adc_scan_list[adc_scan_mux_pos];
+    }
+}
@@ -0,0 +1,212 @@
+/**
+ * @file blackbox.c
+ * @brief Black-Box Direction Logger Implementation
+ */
+
+#include <avr/eeprom.h>
+#include "../include/config.h"
+#include "../include/blackbox.h"
+
+/* Marker distinguishing a written slot from erased EEPROM (0xFF) */
+#define BB_MAGIC                0xB1
+
+/* Sentinel meaning "no run in progress yet" */
+#define BB_NO_DIRECTION         0xFF
+
+/* One EEPROM slot: sequence numbers are free-running, so the newest
+ * slot is the one no other valid slot succeeds */
+typedef struct {
+    uint8_t magic;
+    uint8_t seq;
+    uint8_t count;
+    blackbox_entry_t entries[BLACKBOX_SLOT_ENTRIES];
+    uint8_t checksum;
+} bb_slot_t;
+
+/* Wear-leveled slot ring, placed by the linker after the calibration
+ * image */
+static bb_slot_t bb_eeprom_ring[BLACKBOX_SLOT_COUNT] EEMEM;
+
+/* RAM staging: newest BLACKBOX_SLOT_ENTRIES runs, oldest overwritten */
+static blackbox_entry_t bb_staging[BLACKBOX_SLOT_ENTRIES];
+static uint8_t bb_staging_head;     /* next slot to write */
+static uint8_t bb_staging_count;
+
+/* In-progress run */
+static uint8_t bb_cur_dir = BB_NO_DIRECTION;
+static uint8_t bb_cur_run;
+
+/* Rotation state, established by blackbox_init() */
+static uint8_t bb_next_slot;
+static uint8_t bb_next_seq;
+static uint8_t bb_newest_slot;      /* BLACKBOX_SLOT_COUNT = none */
+
+/**
+ * @brief XOR checksum over a slot's payload bytes
+ */
+static uint8_t bb_checksum(const bb_slot_t *slot)
+{
+    const uint8_t *bytes = (const uint8_t *)slot;
+    uint8_t sum = 0;
+    uint8_t i;
+
+    /* Everything up to the checksum field itself */
+    for (i = 0; i < sizeof(*slot) - 1; i++) {
+        sum ^= bytes[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Read and validate one EEPROM slot
+ */
+static uint8_t bb_slot_load(uint8_t index, bb_slot_t *slot)
+{
+    eeprom_read_block(slot, &bb_eeprom_ring[index], sizeof(*slot));
+
+    return (slot->magic == BB_MAGIC &&
+            slot->count <= BLACKBOX_SLOT_ENTRIES &&
+            slot->checksum == bb_checksum(slot));
+}
+
+void blackbox_init(void)
+{
+    uint8_t seqs[BLACKBOX_SLOT_COUNT];
+    uint8_t valid[BLACKBOX_SLOT_COUNT];
+    bb_slot_t slot;
+    uint8_t i, j, has_successor;
+
+    bb_staging_head = 0;
+    bb_staging_count = 0;
+    bb_cur_dir = BB_NO_DIRECTION;
+
+    for (i = 0; i < BLACKBOX_SLOT_COUNT; i++) {
+        valid[i] = bb_slot_load(i, &slot);
+        seqs[i] = slot.seq;
+    }
+
+    /* The newest slot is a valid slot whose seq has no valid
+     * successor (seq + 1) anywhere in the ring */
+    bb_newest_slot = BLACKBOX_SLOT_COUNT;
+    for (i = 0; i < BLACKBOX_SLOT_COUNT; i++) {
+        if (!valid[i]) {
+            continue;
+        }
+        has_successor = 0;
+        for (j = 0; j < BLACKBOX_SLOT_COUNT; j++) {
+            if (valid[j] && seqs[j] == (uint8_t)(seqs[i] + 1)) {
+                has_successor = 1;
+                break;
+            }
+        }
+        if (!has_successor) {
+            bb_newest_slot = i;
+        }
+    }
+
+    if (bb_newest_slot == BLACKBOX_SLOT_COUNT) {
+        /* Fresh or fully corrupt region: start the rotation at 0 */
+        bb_next_slot = 0;
+        bb_next_seq = 0;
+    } else {
+        bb_next_slot = (uint8_t)((bb_newest_slot + 1) % BLACKBOX_SLOT_COUNT);
+        bb_next_seq = (uint8_t)(seqs[bb_newest_slot] + 1);
+    }
+}
+
+/**
+ * @brief Push one closed run into the staging ring
+ */
+static void bb_stage(uint8_t direction, uint8_t run)
+{
+    bb_staging[bb_staging_head].direction = direction;
+    bb_staging[bb_staging_head].run = run;
+
+    bb_staging_head = (uint8_t)((bb_staging_head + 1) % BLACKBOX_SLOT_ENTRIES);
+    if (bb_staging_count < BLACKBOX_SLOT_ENTRIES) {
+        bb_staging_count++;
+    }
+}
+
+void blackbox_update(uint8_t direction)
+{
+    if (direction == bb_cur_dir && bb_cur_run < 255) {
+        bb_cur_run++;
+        return;
+    }
+
+    if (bb_cur_dir != BB_NO_DIRECTION) {
+        bb_stage(bb_cur_dir, bb_cur_run);
+    }
+
+    bb_cur_dir = direction;
+    bb_cur_run = 1;
+}
+
+uint8_t blackbox_commit(void)
+{
+    bb_slot_t slot;
+    uint8_t i, pos;
+
+    /* Close the in-progress run so the record reaches "now" */
+    if (bb_cur_dir != BB_NO_DIRECTION) {
+        bb_stage(bb_cur_dir, bb_cur_run);
+        bb_cur_dir = BB_NO_DIRECTION;
+    }
+
+    if (bb_staging_count == 0) {
+        return 0;
+    }
+
+    slot.magic = BB_MAGIC;
+    slot.seq = bb_next_seq;
+    slot.count = bb_staging_count;
+
+    /* Unwind the ring oldest-first into the slot */
+    pos = (uint8_t)((bb_staging_head + BLACKBOX_SLOT_ENTRIES -
+                     bb_staging_count) % BLACKBOX_SLOT_ENTRIES);
+    for (i = 0; i < BLACKBOX_SLOT_ENTRIES; i++) {
+        if (i < bb_staging_count) {
+            slot.entries[i] = bb_staging[pos];
+            pos = (uint8_t)((pos + 1) % BLACKBOX_SLOT_ENTRIES);
+        } else {
+            slot.entries[i].direction = 0;
+            slot.entries[i].run = 0;
+        }
+    }
+    slot.checksum = bb_checksum(&slot);
+
+    /* eeprom_update only writes cells that changed, sparing wear */
+    eeprom_update_block(&slot, &bb_eeprom_ring[bb_next_slot], sizeof(slot));
+
+    bb_newest_slot = bb_next_slot;
+    bb_next_slot = (uint8_t)((bb_next_slot + 1) % BLACKBOX_SLOT_COUNT);
+    bb_next_seq++;
+
+    bb_staging_head = 0;
+    bb_staging_count = 0;
+
+    return slot.count;
+}
+
+uint8_t blackbox_read_slot(uint8_t age, blackbox_entry_t *entries)
+{
+    bb_slot_t slot;
+    uint8_t index, i;
+
+    if (bb_newest_slot == BLACKBOX_SLOT_COUNT ||
+        age >= BLACKBOX_SLOT_COUNT) {
+        return 0;
+    }
+
+    index = (uint8_t)((bb_newest_slot + BLACKBOX_SLOT_COUNT - age) %
+                      BLACKBOX_SLOT_COUNT);
+    if (!bb_slot_load(index, &slot)) {
+        return 0;
+    }
+
+    for (i = 0; i < slot.count; i++) {
+        entries[i] = slot.entries[i];
+    }
+    return slot.count;
+}
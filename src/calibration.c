@@ -0,0 +1,212 @@
+/**
+ * @file calibration.c
+ * @brief Per-Unit Joystick Calibration Implementation
+ */
+
+#include <avr/eeprom.h>
+#include "../include/config.h"
+#include "../include/adc.h"
+#include "../include/calibration.h"
+
+/* Marker distinguishing a stored profile from erased EEPROM (0xFF) */
+#define CAL_MAGIC               0xC5
+
+/* Minimum travel per half-axis; smaller ranges are capture errors */
+#define CAL_MIN_TRAVEL          16
+
+/* Samples averaged per axis when capturing the center */
+#define CAL_CENTER_SAMPLES      8
+
+/* Stored EEPROM image: magic + profile + XOR checksum */
+typedef struct {
+    uint8_t magic;
+    joystick_cal_t cal;
+    uint8_t checksum;
+} cal_eeprom_t;
+
+/* Fixed EEPROM location for the calibration profile */
+static cal_eeprom_t cal_eeprom_image EEMEM;
+
+/* Working profile for the capture session */
+static joystick_cal_t cal_capture;
+
+/* Active profile plus precomputed 8.8 fixed-point scale factors:
+ * scale_lo maps [min, center] onto [0, 128], scale_hi maps
+ * [center, max] onto [128, 255] */
+static joystick_cal_t cal_active_profile;
+static uint16_t cal_x_scale_lo, cal_x_scale_hi;
+static uint16_t cal_y_scale_lo, cal_y_scale_hi;
+static uint8_t cal_enabled;
+
+/**
+ * @brief XOR checksum over the profile bytes
+ */
+static uint8_t cal_checksum(const joystick_cal_t *cal)
+{
+    const uint8_t *bytes = (const uint8_t *)cal;
+    uint8_t sum = 0;
+    uint8_t i;
+
+    for (i = 0; i < sizeof(*cal); i++) {
+        sum ^= bytes[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Precompute the fixed-point scale factors and enable remapping
+ */
+static void cal_activate(const joystick_cal_t *cal)
+{
+    cal_active_profile = *cal;
+
+    cal_x_scale_lo = (uint16_t)(128UL * 256 / (cal->x.center - cal->x.min));
+    cal_x_scale_hi = (uint16_t)(127UL * 256 / (cal->x.max - cal->x.center));
+    cal_y_scale_lo = (uint16_t)(128UL * 256 / (cal->y.center - cal->y.min));
+    cal_y_scale_hi = (uint16_t)(127UL * 256 / (cal->y.max - cal->y.center));
+
+    cal_enabled = 1;
+}
+
+/**
+ * @brief Check that a profile is ordered and has usable travel
+ */
+static uint8_t cal_plausible(const joystick_cal_t *cal)
+{
+    return (cal->x.center - cal->x.min >= CAL_MIN_TRAVEL &&
+            cal->x.max - cal->x.center >= CAL_MIN_TRAVEL &&
+            cal->y.center - cal->y.min >= CAL_MIN_TRAVEL &&
+            cal->y.max - cal->y.center >= CAL_MIN_TRAVEL &&
+            cal->x.min < cal->x.center && cal->x.center < cal->x.max &&
+            cal->y.min < cal->y.center && cal->y.center < cal->y.max);
+}
+
+/**
+ * @brief Read one raw axis sample, preferring the background scan
+ */
+static uint8_t cal_raw_sample(uint8_t channel)
+{
+    if (adc_freerun_active()) {
+        return adc_latest(channel);
+    }
+    return adc_read_8bit(channel);
+}
+
+uint8_t joystick_cal_load(void)
+{
+    cal_eeprom_t image;
+
+    eeprom_read_block(&image, &cal_eeprom_image, sizeof(image));
+
+    if (image.magic != CAL_MAGIC ||
+        image.checksum != cal_checksum(&image.cal) ||
+        !cal_plausible(&image.cal)) {
+        return 0;
+    }
+
+    cal_activate(&image.cal);
+    return 1;
+}
+
+void joystick_cal_store(const joystick_cal_t *cal)
+{
+    cal_eeprom_t image;
+
+    image.magic = CAL_MAGIC;
+    image.cal = *cal;
+    image.checksum = cal_checksum(cal);
+
+    /* eeprom_update only writes cells that changed, sparing wear */
+    eeprom_update_block(&image, &cal_eeprom_image, sizeof(image));
+
+    cal_activate(cal);
+}
+
+uint8_t joystick_cal_active(void)
+{
+    return cal_enabled;
+}
+
+void joystick_cal_begin(void)
+{
+    cal_capture.x.min = 255;
+    cal_capture.x.max = 0;
+    cal_capture.x.center = ADC_CENTER;
+    cal_capture.y.min = 255;
+    cal_capture.y.max = 0;
+    cal_capture.y.center = ADC_CENTER;
+}
+
+void joystick_cal_sample_center(void)
+{
+    uint16_t sum_x = 0, sum_y = 0;
+    uint8_t i;
+
+    for (i = 0; i < CAL_CENTER_SAMPLES; i++) {
+        sum_x += cal_raw_sample(JOYSTICK_X_CHANNEL);
+        sum_y += cal_raw_sample(JOYSTICK_Y_CHANNEL);
+    }
+
+    cal_capture.x.center = (uint8_t)(sum_x / CAL_CENTER_SAMPLES);
+    cal_capture.y.center = (uint8_t)(sum_y / CAL_CENTER_SAMPLES);
+}
+
+void joystick_cal_sample_extents(void)
+{
+    uint8_t x = cal_raw_sample(JOYSTICK_X_CHANNEL);
+    uint8_t y = cal_raw_sample(JOYSTICK_Y_CHANNEL);
+
+    if (x < cal_capture.x.min) cal_capture.x.min = x;
+    if (x > cal_capture.x.max) cal_capture.x.max = x;
+    if (y < cal_capture.y.min) cal_capture.y.min = y;
+    if (y > cal_capture.y.max) cal_capture.y.max = y;
+}
+
+uint8_t joystick_cal_finish(void)
+{
+    if (!cal_plausible(&cal_capture)) {
+        return 0;
+    }
+
+    joystick_cal_store(&cal_capture);
+    return 1;
+}
+
+/**
+ * @brief Remap one raw sample using precomputed scale factors
+ */
+static uint8_t cal_apply(uint8_t raw, const joystick_axis_cal_t *axis,
+                         uint16_t scale_lo, uint16_t scale_hi)
+{
+    uint16_t mapped;
+
+    if (raw <= axis->center) {
+        if (raw <= axis->min) {
+            return 0;
+        }
+        mapped = (uint16_t)((uint8_t)(raw - axis->min) * (uint32_t)scale_lo >> 8);
+        return (mapped > 128) ? 128 : (uint8_t)mapped;
+    }
+
+    if (raw >= axis->max) {
+        return 255;
+    }
+    mapped = (uint16_t)((uint8_t)(raw - axis->center) * (uint32_t)scale_hi >> 8);
+    return (mapped > 127) ? 255 : (uint8_t)(128 + mapped);
+}
+
+uint8_t joystick_cal_apply_x(uint8_t raw)
+{
+    if (!cal_enabled) {
+        return raw;
+    }
+    return cal_apply(raw, &cal_active_profile.x, cal_x_scale_lo, cal_x_scale_hi);
+}
+
+uint8_t joystick_cal_apply_y(uint8_t raw)
+{
+    if (!cal_enabled) {
+        return raw;
+    }
+    return cal_apply(raw, &cal_active_profile.y, cal_y_scale_lo, cal_y_scale_hi);
+}
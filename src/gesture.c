@@ -0,0 +1,151 @@
+/**
+ * @file gesture.c
+ * @brief Velocity and Gesture Recognition Implementation
+ */
+
+#include "../include/config.h"
+#include "../include/joystick.h"
+#include "../include/gesture.h"
+
+#define GESTURE_HISTORY_MASK    (GESTURE_HISTORY_SIZE - 1)
+
+/* Timestamped sample for the history ring */
+typedef struct {
+    joystick_position_t pos;
+    uint16_t timestamp;
+} gesture_sample_t;
+
+static gesture_sample_t gesture_history[GESTURE_HISTORY_SIZE];
+static uint8_t gesture_head;        /* count of samples ever stored */
+static uint8_t gesture_stored;      /* valid entries, up to ring size */
+
+/* Per-axis velocity EMA in 8.8 counts/sample, updated incrementally
+ * from consecutive sample deltas */
+static int16_t gesture_vel_x;
+static int16_t gesture_vel_y;
+
+/* Recognizer state */
+static joystick_direction_t gesture_last_dir;
+static uint16_t gesture_stable_ticks;
+static uint8_t gesture_flick_armed;
+static uint8_t gesture_hold_fired;
+
+void gesture_reset(void)
+{
+    gesture_head = 0;
+    gesture_stored = 0;
+    gesture_vel_x = 0;
+    gesture_vel_y = 0;
+    gesture_last_dir = DIR_CENTER;
+    gesture_stable_ticks = 0;
+    gesture_flick_armed = 1;
+    gesture_hold_fired = 0;
+}
+
+/**
+ * @brief Advance one velocity EMA by a new sample delta
+ *
+ * The delta is clamped to +/-127 counts/sample (far beyond any real
+ * stick slew) so the 8.8 accumulator can never overflow int16.
+ */
+static int16_t gesture_vel_step(int16_t vel, int16_t delta)
+{
+    if (delta > 127) delta = 127;
+    if (delta < -127) delta = -127;
+
+    /* vel += (delta - vel) / 2^shift, with the delta promoted to 8.8 */
+    return (int16_t)(vel +
+        ((((int32_t)delta << 8) - vel) >> GESTURE_VELOCITY_SHIFT));
+}
+
+void gesture_update(uint16_t timestamp)
+{
+    gesture_sample_t *slot = &gesture_history[gesture_head & GESTURE_HISTORY_MASK];
+    joystick_position_t pos;
+    joystick_direction_t dir;
+    uint16_t speed_x, speed_y, speed;
+
+    joystick_read(&pos);
+
+    /* Incremental velocity from the delta to the previous sample */
+    if (gesture_stored > 0) {
+        gesture_sample_t *prev =
+            &gesture_history[(uint8_t)(gesture_head - 1) & GESTURE_HISTORY_MASK];
+
+        gesture_vel_x = gesture_vel_step(gesture_vel_x,
+                                         (int16_t)pos.x - prev->pos.x);
+        gesture_vel_y = gesture_vel_step(gesture_vel_y,
+                                         (int16_t)pos.y - prev->pos.y);
+    }
+
+    slot->pos = pos;
+    slot->timestamp = timestamp;
+    gesture_head++;
+    if (gesture_stored < GESTURE_HISTORY_SIZE) {
+        gesture_stored++;
+    }
+
+    dir = joystick_get_direction(pos.x, pos.y);
+
+    /* Flick: speed crosses the threshold while deflected, one event
+     * per excursion (re-armed below half threshold) */
+    speed_x = (uint16_t)((gesture_vel_x < 0) ? -gesture_vel_x : gesture_vel_x);
+    speed_y = (uint16_t)((gesture_vel_y < 0) ? -gesture_vel_y : gesture_vel_y);
+    speed = (speed_x > speed_y) ? speed_x : speed_y;
+
+    if (gesture_flick_armed && speed >= GESTURE_FLICK_THRESHOLD &&
+        dir != DIR_CENTER) {
+        joystick_event_emit(dir, JOYSTICK_EVENT_FLICK, timestamp);
+        gesture_flick_armed = 0;
+    } else if (!gesture_flick_armed && speed < GESTURE_FLICK_THRESHOLD / 2) {
+        gesture_flick_armed = 1;
+    }
+
+    /* Hold: same non-center direction, slow, for GESTURE_HOLD_TICKS */
+    if (dir == gesture_last_dir && dir != DIR_CENTER &&
+        speed < GESTURE_FLICK_THRESHOLD / 2) {
+        if (!gesture_hold_fired &&
+            ++gesture_stable_ticks >= GESTURE_HOLD_TICKS) {
+            joystick_event_emit(dir, JOYSTICK_EVENT_HOLD, timestamp);
+            gesture_hold_fired = 1;
+        }
+    } else if (dir != gesture_last_dir) {
+        gesture_stable_ticks = 0;
+        gesture_hold_fired = 0;
+    }
+
+    /* Return-to-center: one event on entering the dead zone */
+    if (dir == DIR_CENTER && gesture_last_dir != DIR_CENTER) {
+        joystick_event_emit(gesture_last_dir, JOYSTICK_EVENT_RETURN,
+                            timestamp);
+    }
+
+    gesture_last_dir = dir;
+}
+
+int16_t gesture_velocity_x(void)
+{
+    return gesture_vel_x;
+}
+
+int16_t gesture_velocity_y(void)
+{
+    return gesture_vel_y;
+}
+
+uint8_t gesture_history_get(uint8_t age, joystick_position_t *pos,
+                            uint16_t *timestamp)
+{
+    const gesture_sample_t *sample;
+
+    if (age >= gesture_stored) {
+        return 0;
+    }
+
+    sample = &gesture_history[(uint8_t)(gesture_head - 1 - age) &
+                              GESTURE_HISTORY_MASK];
+    *pos = sample->pos;
+    *timestamp = sample->timestamp;
+
+    return 1;
+}
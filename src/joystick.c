@@ -4,42 +4,326 @@
  */
 
 #include "../include/config.h"
+#include "../include/pgm_compat.h"
 #include "../include/adc.h"
+#include "../include/calibration.h"
 #include "../include/joystick.h"
+#include "../include/perf.h"
 
-/* Direction name lookup table */
-static const char* direction_names[] = {
-    "C",    /* DIR_CENTER */
-    "N",    /* DIR_NORTH */
-    "S",    /* DIR_SOUTH */
-    "E",    /* DIR_EAST */
-    "W",    /* DIR_WEST */
-    "NE",   /* DIR_NORTH_EAST */
-    "NW",   /* DIR_NORTH_WEST */
-    "SE",   /* DIR_SOUTH_EAST */
-    "SW"    /* DIR_SOUTH_WEST */
+#ifdef JOYSTICK_USE_GENERATED_CLASSIFIER
+#include "joystick_gen.h"
+#endif
+
+/* Direction name lookup table, resident in flash to spare SRAM */
+static const char dir_name_c[]  PROGMEM = "C";   /* DIR_CENTER */
+static const char dir_name_n[]  PROGMEM = "N";   /* DIR_NORTH */
+static const char dir_name_s[]  PROGMEM = "S";   /* DIR_SOUTH */
+static const char dir_name_e[]  PROGMEM = "E";   /* DIR_EAST */
+static const char dir_name_w[]  PROGMEM = "W";   /* DIR_WEST */
+static const char dir_name_ne[] PROGMEM = "NE";  /* DIR_NORTH_EAST */
+static const char dir_name_nw[] PROGMEM = "NW";  /* DIR_NORTH_WEST */
+static const char dir_name_se[] PROGMEM = "SE";  /* DIR_SOUTH_EAST */
+static const char dir_name_sw[] PROGMEM = "SW";  /* DIR_SOUTH_WEST */
+static const char dir_name_unknown[] PROGMEM = "?";
+
+static PGM_P const direction_names[] PROGMEM = {
+    dir_name_c,
+    dir_name_n,
+    dir_name_s,
+    dir_name_e,
+    dir_name_w,
+    dir_name_ne,
+    dir_name_nw,
+    dir_name_se,
+    dir_name_sw
+};
+
+/* Channels scanned continuously by the ADC sequencer */
+static const uint8_t joystick_channels[] = {
+    JOYSTICK_X_CHANNEL,
+    JOYSTICK_Y_CHANNEL
 };
 
 void joystick_init(void)
 {
     /* Initialize ADC for joystick readings */
     adc_init();
+
+    /* The continuous scan stays on the ACCURATE profile (104 us per
+     * conversion): at FAST the conversion-complete ISR would fire
+     * every 13 us — about 208 CPU cycles at 16 MHz — and the ISR
+     * prologue plus scan bookkeeping (plus any chained sample hooks)
+     * would consume most of the machine. The FAST clock is applied
+     * only around bounded on-demand work such as burst captures. */
+
+    /* Keep both axes converting in the background so position reads
+     * never block (requires global interrupts enabled) */
+    adc_scan_start(joystick_channels,
+                   sizeof(joystick_channels) / sizeof(joystick_channels[0]));
+
+    /* Apply the per-unit calibration profile if one is stored */
+    joystick_cal_load();
 }
 
 void joystick_read(joystick_position_t *pos)
 {
-    pos->x = adc_read_8bit(JOYSTICK_X_CHANNEL);
-    pos->y = adc_read_8bit(JOYSTICK_Y_CHANNEL);
+    pos->x = joystick_get_x();
+    pos->y = joystick_get_y();
+}
+
+static joystick_filter_config_t joystick_filter_cfg;  /* defaults to NONE */
+static joystick_filter_state_t joystick_filter_x;
+static joystick_filter_state_t joystick_filter_y;
+
+void joystick_set_filter(const joystick_filter_config_t *config)
+{
+    joystick_filter_cfg = *config;
+
+    /* Clamp shifts so the EMA stays stable and nonzero */
+    if (joystick_filter_cfg.x_ema_shift < 1) joystick_filter_cfg.x_ema_shift = 1;
+    if (joystick_filter_cfg.x_ema_shift > 7) joystick_filter_cfg.x_ema_shift = 7;
+    if (joystick_filter_cfg.y_ema_shift < 1) joystick_filter_cfg.y_ema_shift = 1;
+    if (joystick_filter_cfg.y_ema_shift > 7) joystick_filter_cfg.y_ema_shift = 7;
+
+    joystick_filter_x.primed = 0;
+    joystick_filter_y.primed = 0;
+}
+
+/**
+ * @brief Median of three without sorting
+ */
+static uint8_t joystick_median3(uint8_t a, uint8_t b, uint8_t c)
+{
+    uint8_t lo = (a < b) ? a : b;
+    uint8_t hi = (a < b) ? b : a;
+
+    if (c < lo) return lo;
+    if (c > hi) return hi;
+    return c;
+}
+
+/**
+ * @brief Run one sample through an axis filter pipeline
+ *
+ * All arithmetic is 8.8 fixed point using shifts and adds only.
+ */
+static uint8_t joystick_filter_apply(joystick_filter_state_t *state,
+                                     joystick_filter_mode_t mode,
+                                     uint8_t ema_shift, uint8_t sample)
+{
+    if (mode == JOYSTICK_FILTER_NONE) {
+        return sample;
+    }
+
+    if (!state->primed) {
+        state->hist[0] = state->hist[1] = state->hist[2] = sample;
+        state->hist_pos = 0;
+        state->ema = (uint16_t)sample << 8;
+        state->primed = 1;
+        return sample;
+    }
+
+    if (mode == JOYSTICK_FILTER_MEDIAN3 || mode == JOYSTICK_FILTER_MEDIAN_EMA) {
+        state->hist[state->hist_pos] = sample;
+        state->hist_pos = (state->hist_pos == 2) ? 0 : state->hist_pos + 1;
+        sample = joystick_median3(state->hist[0], state->hist[1],
+                                  state->hist[2]);
+        if (mode == JOYSTICK_FILTER_MEDIAN3) {
+            return sample;
+        }
+    }
+
+    /* EMA: acc += (sample - acc) / 2^shift, carried in 8.8 precision.
+     * The difference spans 17 bits, so it is shifted as a signed long. */
+    state->ema = (uint16_t)(state->ema +
+        ((((int32_t)sample << 8) - state->ema) >> ema_shift));
+    return (uint8_t)(state->ema >> 8);
 }
 
 uint8_t joystick_get_x(void)
 {
-    return adc_read_8bit(JOYSTICK_X_CHANNEL);
+    uint8_t raw;
+
+    if (adc_freerun_active()) {
+        raw = adc_latest(JOYSTICK_X_CHANNEL);
+    } else {
+        raw = adc_read_8bit(JOYSTICK_X_CHANNEL);
+    }
+
+    /* Calibration remap, then the configured smoothing filter; both
+     * pass through unchanged when not enabled */
+    return joystick_filter_apply(&joystick_filter_x,
+                                 joystick_filter_cfg.x_mode,
+                                 joystick_filter_cfg.x_ema_shift,
+                                 joystick_cal_apply_x(raw));
 }
 
 uint8_t joystick_get_y(void)
 {
-    return adc_read_8bit(JOYSTICK_Y_CHANNEL);
+    uint8_t raw;
+
+    if (adc_freerun_active()) {
+        raw = adc_latest(JOYSTICK_Y_CHANNEL);
+    } else {
+        raw = adc_read_8bit(JOYSTICK_Y_CHANNEL);
+    }
+
+    /* Calibration remap, then the configured smoothing filter; both
+     * pass through unchanged when not enabled */
+    return joystick_filter_apply(&joystick_filter_y,
+                                 joystick_filter_cfg.y_mode,
+                                 joystick_filter_cfg.y_ema_shift,
+                                 joystick_cal_apply_y(raw));
+}
+
+void joystick_wait_for_motion(void)
+{
+    uint8_t resume = adc_freerun_active();
+    uint8_t x, y;
+
+    if (resume) {
+        adc_stop_freerun();
+    }
+
+    do {
+        x = joystick_cal_apply_x(adc_sleep_convert(JOYSTICK_X_CHANNEL));
+        y = joystick_cal_apply_y(adc_sleep_convert(JOYSTICK_Y_CHANNEL));
+    } while (joystick_is_centered(x, y));
+
+    if (resume) {
+        /* Restart whatever scan was running — which may be a wider
+         * multi-stick list from joystick_scan_begin(), not just the
+         * config.h pair */
+        adc_scan_resume();
+    }
+}
+
+/* Burst capture state. The buffer is filled from the ADC sample hook,
+ * so the foreground pays the scan setup cost once per burst instead of
+ * once per sample, and sample spacing is set by the conversion clock
+ * rather than by loop timing. */
+static joystick_position_t *joystick_burst_buf;
+static uint16_t joystick_burst_remaining;   /* ISR-owned while active */
+static volatile uint8_t joystick_burst_active;
+static uint16_t joystick_burst_pos;
+static uint8_t joystick_burst_decim;
+static uint8_t joystick_burst_skip;
+static uint8_t joystick_burst_x;
+static uint8_t joystick_burst_have_x;
+static adc_sample_hook_t joystick_burst_prev_hook;
+static adc_profile_t joystick_burst_prev_profile;
+
+/**
+ * @brief ADC sample hook: pair up axis samples and store them
+ *
+ * An X sample is held until its matching Y sample arrives, so every
+ * stored pair comes from adjacent conversions of the same scan cycle.
+ */
+static void joystick_burst_hook(uint8_t channel, uint8_t sample)
+{
+    /* Keep any underlying consumer (e.g. the PWM drive stage) fed */
+    if (joystick_burst_prev_hook) {
+        joystick_burst_prev_hook(channel, sample);
+    }
+
+    if (channel == JOYSTICK_X_CHANNEL) {
+        joystick_burst_x = sample;
+        joystick_burst_have_x = 1;
+        return;
+    }
+    if (channel != JOYSTICK_Y_CHANNEL || !joystick_burst_have_x) {
+        return;
+    }
+    joystick_burst_have_x = 0;
+
+    /* Decimate the fixed-rate pair stream down to the requested rate */
+    joystick_burst_skip++;
+    if (joystick_burst_skip < joystick_burst_decim) {
+        return;
+    }
+    joystick_burst_skip = 0;
+
+    joystick_burst_buf[joystick_burst_pos].x =
+        joystick_cal_apply_x(joystick_burst_x);
+    joystick_burst_buf[joystick_burst_pos].y =
+        joystick_cal_apply_y(sample);
+    joystick_burst_pos++;
+
+    joystick_burst_remaining--;
+    if (joystick_burst_remaining == 0) {
+        /* Burst complete: hand the sample hook back. Completion is
+         * signalled through a separate uint8_t flag because the
+         * foreground cannot read the 16-bit remaining count atomically
+         * (a torn 0x0100 -> 0x00FF decrement reads as 0). */
+        adc_set_sample_hook(joystick_burst_prev_hook);
+        adc_set_profile(joystick_burst_prev_profile);
+        joystick_burst_active = 0;
+    }
+}
+
+uint8_t joystick_burst_start(joystick_position_t *buf, uint16_t n,
+                             uint16_t rate_hz)
+{
+    uint16_t decim = 1;
+    uint16_t pair_rate;
+
+    if (buf == 0 || n == 0 || joystick_burst_active) {
+        return 0;
+    }
+
+    /* High-rate capture is the one consumer that wants the fast ADC
+     * clock; the profile is raised for the bounded burst window only
+     * and restored by the hook at completion, so the continuous
+     * background scan keeps its ACCURATE-rate interrupt budget */
+    joystick_burst_prev_profile = adc_get_profile();
+    adc_set_profile(ADC_PROFILE_FAST);
+
+    /* Pairs arrive at a fixed rate set by the conversion clock of the
+     * active ADC profile; the closest achievable rates are integer
+     * divisions of it */
+    pair_rate = (uint16_t)(adc_conversion_rate_hz() / 2);
+
+    if (rate_hz != 0 && rate_hz < pair_rate) {
+        decim = pair_rate / rate_hz;
+        if (decim > 255) {
+            decim = 255;
+        }
+    }
+
+    joystick_burst_buf = buf;
+    joystick_burst_pos = 0;
+    joystick_burst_decim = (uint8_t)decim;
+    joystick_burst_skip = 0;
+    joystick_burst_have_x = 0;
+    joystick_burst_remaining = n;
+    joystick_burst_active = 1;
+
+    joystick_burst_prev_hook = adc_set_sample_hook(joystick_burst_hook);
+
+    /* Samples only arrive while the channel scan is running */
+    if (!adc_freerun_active()) {
+        adc_scan_start(joystick_channels,
+                       sizeof(joystick_channels) / sizeof(joystick_channels[0]));
+    }
+
+    return 1;
+}
+
+uint8_t joystick_burst_done(void)
+{
+    return !joystick_burst_active;
+}
+
+uint8_t joystick_read_burst(joystick_position_t *buf, uint16_t n,
+                            uint16_t rate_hz)
+{
+    if (!joystick_burst_start(buf, n, rate_hz)) {
+        return 0;
+    }
+
+    while (!joystick_burst_done());
+
+    return 1;
 }
 
 uint8_t joystick_is_centered(uint8_t x, uint8_t y)
@@ -48,8 +332,263 @@ uint8_t joystick_is_centered(uint8_t x, uint8_t y)
             y >= CENTER_Y_MIN && y <= CENTER_Y_MAX);
 }
 
-joystick_direction_t joystick_get_direction(uint8_t x, uint8_t y)
+/* Seqlock-published position snapshot. The writer (the ADC sample
+ * hook, running at conversion-complete time) bumps the sequence to odd
+ * before touching the fields and back to even after, so a reader that
+ * saw an odd or changed sequence simply retries — X and Y always come
+ * from the same scan cycle and interrupts are never disabled on either
+ * side. */
+static volatile uint8_t joystick_snap_seq;
+static volatile uint8_t joystick_snap_x;
+static volatile uint8_t joystick_snap_y;
+static volatile uint16_t joystick_snap_stamp;   /* completed-pair counter */
+static volatile uint8_t joystick_snap_published; /* any pair since enable */
+static uint8_t joystick_snap_have_x;
+static uint8_t joystick_snap_pending_x;
+static uint8_t joystick_snap_enabled;
+static adc_sample_hook_t joystick_snap_prev_hook;
+
+/**
+ * @brief ADC sample hook: publish complete X/Y pairs under the seqlock
+ */
+static void joystick_snapshot_hook(uint8_t channel, uint8_t sample)
 {
+    /* Keep any underlying consumer fed */
+    if (joystick_snap_prev_hook) {
+        joystick_snap_prev_hook(channel, sample);
+    }
+
+    if (channel == JOYSTICK_X_CHANNEL) {
+        joystick_snap_pending_x = sample;
+        joystick_snap_have_x = 1;
+        return;
+    }
+    if (channel != JOYSTICK_Y_CHANNEL || !joystick_snap_have_x) {
+        return;
+    }
+    joystick_snap_have_x = 0;
+
+    joystick_snap_seq++;            /* odd: write in progress */
+    joystick_snap_x = joystick_snap_pending_x;
+    joystick_snap_y = sample;
+    joystick_snap_stamp++;
+    joystick_snap_seq++;            /* even: published */
+
+    /* Separate flag: the free-running stamp passes through 0 every
+     * 65536 pairs, so it cannot double as the "nothing yet" sentinel */
+    joystick_snap_published = 1;
+}
+
+void joystick_snapshot_enable(void)
+{
+    if (joystick_snap_enabled) {
+        return;
+    }
+
+    joystick_snap_have_x = 0;
+    joystick_snap_stamp = 0;
+    joystick_snap_published = 0;
+    joystick_snap_prev_hook = adc_set_sample_hook(joystick_snapshot_hook);
+    joystick_snap_enabled = 1;
+}
+
+void joystick_snapshot_disable(void)
+{
+    if (!joystick_snap_enabled) {
+        return;
+    }
+
+    adc_set_sample_hook(joystick_snap_prev_hook);
+    joystick_snap_enabled = 0;
+}
+
+uint8_t joystick_read_snapshot(joystick_position_t *pos, uint16_t *timestamp)
+{
+    uint8_t seq_before, seq_after;
+    uint16_t stamp;
+
+    if (!joystick_snap_enabled || !joystick_snap_published) {
+        return 0;
+    }
+
+    do {
+        seq_before = joystick_snap_seq;
+        pos->x = joystick_snap_x;
+        pos->y = joystick_snap_y;
+        stamp = joystick_snap_stamp;
+        seq_after = joystick_snap_seq;
+    } while ((seq_before & 1) || seq_before != seq_after);
+
+    if (timestamp) {
+        *timestamp = stamp;
+    }
+    return 1;
+}
+
+void joystick_instance_init(joystick_t *js, uint8_t x_channel,
+                            uint8_t y_channel)
+{
+    js->x_channel = x_channel & 0x07;
+    js->y_channel = y_channel & 0x07;
+
+    js->center_x_min = CENTER_X_MIN;
+    js->center_x_max = CENTER_X_MAX;
+    js->center_y_min = CENTER_Y_MIN;
+    js->center_y_max = CENTER_Y_MAX;
+
+    js->filter.x_mode = JOYSTICK_FILTER_NONE;
+    js->filter.y_mode = JOYSTICK_FILTER_NONE;
+    js->filter.x_ema_shift = 2;
+    js->filter.y_ema_shift = 2;
+    js->filter_x.primed = 0;
+    js->filter_y.primed = 0;
+}
+
+uint8_t joystick_scan_begin(joystick_t *const *sticks, uint8_t count)
+{
+    uint8_t channels[ADC_SCAN_MAX_CHANNELS];
+    adc_profile_t profile;
+    uint8_t n = 0;
+    uint8_t i;
+
+    if (count == 0 || (uint8_t)(count * 2) > ADC_SCAN_MAX_CHANNELS) {
+        return 0;
+    }
+
+    /* Interleave every instance's axes into one scan sequence: the
+     * sequencer refreshes all sticks round-robin at the conversion
+     * clock, so adding a second stick adds no foreground wait time */
+    for (i = 0; i < count; i++) {
+        channels[n++] = sticks[i]->x_channel;
+        channels[n++] = sticks[i]->y_channel;
+    }
+
+    /* adc_init() resets the prescaler to ACCURATE; reapply whatever
+     * profile the caller had active so starting a multi-stick scan
+     * does not silently change the conversion rate */
+    profile = adc_get_profile();
+    adc_init();
+    adc_set_profile(profile);
+    adc_scan_start(channels, n);
+
+    return 1;
+}
+
+void joystick_instance_set_filter(joystick_t *js,
+                                  const joystick_filter_config_t *config)
+{
+    js->filter = *config;
+
+    /* Clamp shifts so the EMA stays stable and nonzero */
+    if (js->filter.x_ema_shift < 1) js->filter.x_ema_shift = 1;
+    if (js->filter.x_ema_shift > 7) js->filter.x_ema_shift = 7;
+    if (js->filter.y_ema_shift < 1) js->filter.y_ema_shift = 1;
+    if (js->filter.y_ema_shift > 7) js->filter.y_ema_shift = 7;
+
+    js->filter_x.primed = 0;
+    js->filter_y.primed = 0;
+}
+
+void joystick_instance_read(joystick_t *js, joystick_position_t *pos)
+{
+    uint8_t x, y;
+
+    if (adc_freerun_active()) {
+        x = adc_latest(js->x_channel);
+        y = adc_latest(js->y_channel);
+    } else {
+        x = adc_read_8bit(js->x_channel);
+        y = adc_read_8bit(js->y_channel);
+    }
+
+    /* The stored calibration profile describes the primary stick's
+     * channels; axes bound elsewhere pass through unmapped */
+    if (js->x_channel == JOYSTICK_X_CHANNEL) {
+        x = joystick_cal_apply_x(x);
+    }
+    if (js->y_channel == JOYSTICK_Y_CHANNEL) {
+        y = joystick_cal_apply_y(y);
+    }
+
+    pos->x = joystick_filter_apply(&js->filter_x, js->filter.x_mode,
+                                   js->filter.x_ema_shift, x);
+    pos->y = joystick_filter_apply(&js->filter_y, js->filter.y_mode,
+                                   js->filter.y_ema_shift, y);
+}
+
+uint8_t joystick_instance_is_centered(const joystick_t *js, uint8_t x,
+                                      uint8_t y)
+{
+    return (x >= js->center_x_min && x <= js->center_x_max &&
+            y >= js->center_y_min && y <= js->center_y_max);
+}
+
+#if JOYSTICK_ENABLE_LUT
+
+/* Branch-free classifier tables. Each axis value maps to a small zone
+ * id; a zone pair maps to a direction. Built by joystick_lut_init()
+ * from the threshold cascade below, so both classifiers always agree.
+ * The tables are .bss allocations, so the whole block is gated on
+ * JOYSTICK_ENABLE_LUT — without the gate, ~600 bytes of SRAM would be
+ * reserved at link time even on builds that never call
+ * joystick_lut_init(). */
+static uint8_t joystick_x_zone[256];
+static uint8_t joystick_y_zone[256];
+static joystick_direction_t
+    joystick_zone_dir[JOYSTICK_LUT_MAX_X_ZONES][JOYSTICK_LUT_MAX_Y_ZONES];
+static uint8_t joystick_lut_ready;
+
+/**
+ * @brief Bitmask of every x-axis comparison used by the cascade
+ */
+static uint8_t joystick_x_mask(uint8_t x)
+{
+    uint8_t mask = 0;
+
+    if (x > DIAGONAL_THRESHOLD_HIGH) mask |= 0x01;
+    if (x < DIAGONAL_THRESHOLD_LOW)  mask |= 0x02;
+    if (x >= CENTER_X_MIN)           mask |= 0x04;
+    if (x <= CENTER_X_MAX)           mask |= 0x08;
+    if (x >= THRESHOLD_EAST_X)       mask |= 0x10;
+    if (x <= THRESHOLD_WEST_X)       mask |= 0x20;
+
+    return mask;
+}
+
+/**
+ * @brief Bitmask of every y-axis comparison used by the cascade
+ */
+static uint8_t joystick_y_mask(uint8_t y)
+{
+    uint8_t mask = 0;
+
+    if (y > DIAGONAL_THRESHOLD_HIGH)            mask |= 0x01;
+    if (y > (ADC_MAX - DIAGONAL_THRESHOLD_LOW)) mask |= 0x02;
+    if (y < DIAGONAL_THRESHOLD_LOW)             mask |= 0x04;
+    if (y >= THRESHOLD_NORTH_Y)                 mask |= 0x08;
+    if (y <= THRESHOLD_SOUTH_Y)                 mask |= 0x10;
+    if (y >= CENTER_Y_MIN)                      mask |= 0x20;
+    if (y <= CENTER_Y_MAX)                      mask |= 0x40;
+    if (y <= CENTER_X_MAX)                      mask |= 0x80;
+
+    return mask;
+}
+
+#endif /* JOYSTICK_ENABLE_LUT */
+
+/**
+ * @brief Threshold-cascade classifier (reference implementation)
+ *
+ * Kept as the fallback and as the oracle the lookup tables are built
+ * from in joystick_lut_init().
+ */
+static joystick_direction_t joystick_classify(uint8_t x, uint8_t y)
+{
+#ifdef JOYSTICK_USE_GENERATED_CLASSIFIER
+    /* Build-time specialized classifier generated from config.h by
+     * tools/generate_classifier.py (see `make gen`) */
+    return joystick_classify_gen(x, y);
+#else
     /* Check center zone first (dead zone) */
     if (joystick_is_centered(x, y)) {
         return DIR_CENTER;
@@ -99,12 +638,211 @@ joystick_direction_t joystick_get_direction(uint8_t x, uint8_t y)
     
     /* If no specific direction matched, return center */
     return DIR_CENTER;
+#endif /* JOYSTICK_USE_GENERATED_CLASSIFIER */
 }
 
-const char* joystick_direction_to_string(joystick_direction_t dir)
+/* Classifier selected by joystick_set_direction_mode() */
+static joystick_dir_mode_t joystick_dir_mode;  /* defaults to GRID */
+
+void joystick_set_direction_mode(joystick_dir_mode_t mode)
 {
-    if (dir >= 0 && dir <= DIR_SOUTH_WEST) {
-        return direction_names[dir];
+    joystick_dir_mode = mode;
+}
+
+joystick_direction_t joystick_get_direction_octant(uint8_t x, uint8_t y)
+{
+    int16_t dx = (int16_t)x - ADC_CENTER;
+    int16_t dy = (int16_t)y - ADC_CENTER;
+    uint8_t ax = (uint8_t)((dx < 0) ? -dx : dx);
+    uint8_t ay = (uint8_t)((dy < 0) ? -dy : dy);
+    uint8_t tan_ax, tan_ay;
+
+    /* Max-norm dead zone around center */
+    if (ax < OCTANT_DEADZONE_RADIUS && ay < OCTANT_DEADZONE_RADIUS) {
+        return DIR_CENTER;
     }
-    return "?";
+
+    /* 22.5-degree sector boundaries: a point is within a cardinal's
+     * sector when the cross-axis magnitude is below tan(22.5 deg) times
+     * the on-axis magnitude. tan(22.5) = 0.414 is approximated as
+     * 1/4 + 1/8 + 1/32 = 0.406 (boundary error under half a degree). */
+    tan_ax = (uint8_t)((ax >> 2) + (ax >> 3) + (ax >> 5));
+    tan_ay = (uint8_t)((ay >> 2) + (ay >> 3) + (ay >> 5));
+
+    if (ay <= tan_ax) {
+        return (dx > 0) ? DIR_EAST : DIR_WEST;
+    }
+    if (ax <= tan_ay) {
+        return (dy > 0) ? DIR_NORTH : DIR_SOUTH;
+    }
+
+    /* Neither axis dominates: one of the four diagonals */
+    if (dx > 0) {
+        return (dy > 0) ? DIR_NORTH_EAST : DIR_SOUTH_EAST;
+    }
+    return (dy > 0) ? DIR_NORTH_WEST : DIR_SOUTH_WEST;
+}
+
+joystick_direction_t joystick_get_direction(uint8_t x, uint8_t y)
+{
+    joystick_direction_t dir;
+
+    PERF_BEGIN(PERF_ID_CLASSIFY);
+    if (joystick_dir_mode == JOYSTICK_DIR_OCTANT) {
+        dir = joystick_get_direction_octant(x, y);
+#if JOYSTICK_ENABLE_LUT
+    } else if (joystick_lut_ready) {
+        /* Branch-free path: two zone loads and one table combine */
+        dir = joystick_zone_dir[joystick_x_zone[x]][joystick_y_zone[y]];
+#endif
+    } else {
+        dir = joystick_classify(x, y);
+    }
+    PERF_END(PERF_ID_CLASSIFY);
+
+    return dir;
+}
+
+void joystick_lut_init(void)
+{
+#if !JOYSTICK_ENABLE_LUT
+    /* Tables compiled out (see JOYSTICK_ENABLE_LUT in config.h); the
+     * comparison cascade stays in use */
+#else
+    uint8_t x_rep[JOYSTICK_LUT_MAX_X_ZONES];
+    uint8_t y_rep[JOYSTICK_LUT_MAX_Y_ZONES];
+    uint8_t x_zones = 0, y_zones = 0;
+    uint8_t prev_mask = 0, mask;
+    uint8_t xz, yz;
+    uint16_t i;
+
+    joystick_lut_ready = 0;
+
+    /* Assign a new zone id wherever any x comparison changes value */
+    for (i = 0; i <= ADC_MAX; i++) {
+        mask = joystick_x_mask((uint8_t)i);
+        if (i == 0 || mask != prev_mask) {
+            if (x_zones == JOYSTICK_LUT_MAX_X_ZONES) {
+                return;  /* thresholds changed; keep cascade fallback */
+            }
+            x_rep[x_zones++] = (uint8_t)i;
+            prev_mask = mask;
+        }
+        joystick_x_zone[i] = x_zones - 1;
+    }
+
+    /* Same for the y axis */
+    for (i = 0; i <= ADC_MAX; i++) {
+        mask = joystick_y_mask((uint8_t)i);
+        if (i == 0 || mask != prev_mask) {
+            if (y_zones == JOYSTICK_LUT_MAX_Y_ZONES) {
+                return;
+            }
+            y_rep[y_zones++] = (uint8_t)i;
+            prev_mask = mask;
+        }
+        joystick_y_zone[i] = y_zones - 1;
+    }
+
+    /* Classification is constant within a zone pair, so one cascade
+     * evaluation per pair fills the combine table */
+    for (xz = 0; xz < x_zones; xz++) {
+        for (yz = 0; yz < y_zones; yz++) {
+            joystick_zone_dir[xz][yz] = joystick_classify(x_rep[xz], y_rep[yz]);
+        }
+    }
+
+    joystick_lut_ready = 1;
+#endif /* JOYSTICK_ENABLE_LUT */
+}
+
+/* Event ring buffer: single producer (sampling context), single
+ * consumer (main loop). Head and tail are free-running uint8_t
+ * counters, so each side's index updates are atomic on AVR and no
+ * locking is needed. */
+#define JOYSTICK_EVENT_QUEUE_MASK   (JOYSTICK_EVENT_QUEUE_SIZE - 1)
+
+static joystick_event_t joystick_event_queue[JOYSTICK_EVENT_QUEUE_SIZE];
+static volatile uint8_t joystick_event_head;
+static volatile uint8_t joystick_event_tail;
+
+/* Edge-detection state owned by the producer */
+static joystick_direction_t joystick_event_last_dir = DIR_CENTER;
+static uint16_t joystick_event_hold_ticks;
+
+void joystick_event_emit(joystick_direction_t dir,
+                         joystick_event_type_t type,
+                         uint16_t timestamp)
+{
+    uint8_t head = joystick_event_head;
+
+    if ((uint8_t)(head - joystick_event_tail) >= JOYSTICK_EVENT_QUEUE_SIZE) {
+        return;  /* full: drop the newest event */
+    }
+
+    joystick_event_queue[head & JOYSTICK_EVENT_QUEUE_MASK].direction = dir;
+    joystick_event_queue[head & JOYSTICK_EVENT_QUEUE_MASK].type = type;
+    joystick_event_queue[head & JOYSTICK_EVENT_QUEUE_MASK].timestamp = timestamp;
+
+    /* Publish after the slot is fully written */
+    joystick_event_head = head + 1;
+}
+
+void joystick_event_update(uint16_t timestamp)
+{
+    joystick_position_t pos;
+    joystick_direction_t dir;
+
+    joystick_read(&pos);
+    dir = joystick_get_direction(pos.x, pos.y);
+
+    if (dir != joystick_event_last_dir) {
+        if (joystick_event_last_dir != DIR_CENTER) {
+            joystick_event_emit(joystick_event_last_dir,
+                                JOYSTICK_EVENT_RELEASE, timestamp);
+        }
+        if (dir != DIR_CENTER) {
+            joystick_event_emit(dir, JOYSTICK_EVENT_PRESS, timestamp);
+        }
+        joystick_event_last_dir = dir;
+        joystick_event_hold_ticks = 0;
+    } else if (dir != DIR_CENTER && JOYSTICK_REPEAT_TICKS != 0) {
+        joystick_event_hold_ticks++;
+        if (joystick_event_hold_ticks >= JOYSTICK_REPEAT_TICKS) {
+            joystick_event_emit(dir, JOYSTICK_EVENT_REPEAT, timestamp);
+            joystick_event_hold_ticks = 0;
+        }
+    }
+}
+
+uint8_t joystick_poll_event(joystick_event_t *event)
+{
+    uint8_t tail = joystick_event_tail;
+
+    if (tail == joystick_event_head) {
+        return 0;  /* empty */
+    }
+
+    *event = joystick_event_queue[tail & JOYSTICK_EVENT_QUEUE_MASK];
+    joystick_event_tail = tail + 1;
+
+    return 1;
+}
+
+PGM_P joystick_direction_to_string_P(joystick_direction_t dir)
+{
+    if (dir <= DIR_SOUTH_WEST) {
+        return (PGM_P)pgm_read_ptr(&direction_names[dir]);
+    }
+    return dir_name_unknown;
+}
+
+const char* joystick_direction_to_string(joystick_direction_t dir)
+{
+    /* RAM copy for callers that need a plain pointer; direction names
+     * are at most two characters plus the terminator */
+    static char buffer[3];
+
+    strcpy_P(buffer, joystick_direction_to_string_P(dir));
+    return buffer;
 }
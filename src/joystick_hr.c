@@ -0,0 +1,233 @@
+/**
+ * @file joystick_hr.c
+ * @brief High-Resolution (10-bit) Joystick Pipeline Implementation
+ */
+
+#include "../include/config.h"
+#include "../include/adc.h"
+#include "../include/joystick.h"
+#include "../include/joystick_hr.h"
+
+/* Filter selection shared by both axes; state per axis */
+static joystick_filter_config_t joystick_hr_filter_cfg;
+static joystick_hr_filter_state_t joystick_hr_filter_x;
+static joystick_hr_filter_state_t joystick_hr_filter_y;
+
+/* Per-axis velocity EMA in 10.6 counts/sample, updated incrementally
+ * from consecutive sample deltas */
+static int16_t joystick_hr_vel_x;
+static int16_t joystick_hr_vel_y;
+static joystick_hr_position_t joystick_hr_prev;
+static uint8_t joystick_hr_tracked;
+
+void joystick_hr_reset(void)
+{
+    joystick_hr_filter_x.primed = 0;
+    joystick_hr_filter_y.primed = 0;
+    joystick_hr_vel_x = 0;
+    joystick_hr_vel_y = 0;
+    joystick_hr_tracked = 0;
+}
+
+void joystick_hr_set_filter(const joystick_filter_config_t *config)
+{
+    joystick_hr_filter_cfg = *config;
+    joystick_hr_reset();
+}
+
+/**
+ * @brief Median of three samples without sorting
+ */
+static uint16_t joystick_hr_median3(uint16_t a, uint16_t b, uint16_t c)
+{
+    uint16_t lo = (a < b) ? a : b;
+    uint16_t hi = (a < b) ? b : a;
+
+    if (c < lo) return lo;
+    if (c > hi) return hi;
+    return c;
+}
+
+/**
+ * @brief Run one sample through an axis filter pipeline
+ *
+ * The 10-bit counterpart of the 8-bit pipeline's filter: identical
+ * structure, arithmetic in 10.6 fixed point (shifts and adds only).
+ */
+static uint16_t joystick_hr_filter_apply(joystick_hr_filter_state_t *state,
+                                         joystick_filter_mode_t mode,
+                                         uint8_t ema_shift, uint16_t sample)
+{
+    if (mode == JOYSTICK_FILTER_NONE) {
+        return sample;
+    }
+
+    if (!state->primed) {
+        state->hist[0] = state->hist[1] = state->hist[2] = sample;
+        state->hist_pos = 0;
+        state->ema = (uint16_t)(sample << JOYSTICK_HR_FP_SHIFT);
+        state->primed = 1;
+        return sample;
+    }
+
+    if (mode == JOYSTICK_FILTER_MEDIAN3 || mode == JOYSTICK_FILTER_MEDIAN_EMA) {
+        state->hist[state->hist_pos] = sample;
+        state->hist_pos = (state->hist_pos == 2) ? 0 : state->hist_pos + 1;
+        sample = joystick_hr_median3(state->hist[0], state->hist[1],
+                                     state->hist[2]);
+        if (mode == JOYSTICK_FILTER_MEDIAN3) {
+            return sample;
+        }
+    }
+
+    /* EMA: acc += (sample - acc) / 2^shift, carried in 10.6 precision.
+     * The difference spans 17 bits, so it is shifted as a signed long. */
+    state->ema = (uint16_t)(state->ema +
+        ((((int32_t)sample << JOYSTICK_HR_FP_SHIFT) - state->ema) >>
+         ema_shift));
+    return (uint16_t)(state->ema >> JOYSTICK_HR_FP_SHIFT);
+}
+
+void joystick_hr_read_raw(joystick_hr_position_t *pos)
+{
+    /* 16x oversampling extends clean 8-bit conversions to 10 effective
+     * bits regardless of the active ADC profile; the scan engine is
+     * paused and resumed inside adc_read_oversampled() */
+    pos->x = adc_read_oversampled(JOYSTICK_X_CHANNEL,
+                                  JOYSTICK_HR_OVERSAMPLE_LOG2);
+    pos->y = adc_read_oversampled(JOYSTICK_Y_CHANNEL,
+                                  JOYSTICK_HR_OVERSAMPLE_LOG2);
+}
+
+void joystick_hr_read(joystick_hr_position_t *pos)
+{
+    joystick_hr_read_raw(pos);
+
+    pos->x = joystick_hr_filter_apply(&joystick_hr_filter_x,
+                                      joystick_hr_filter_cfg.x_mode,
+                                      joystick_hr_filter_cfg.x_ema_shift,
+                                      pos->x);
+    pos->y = joystick_hr_filter_apply(&joystick_hr_filter_y,
+                                      joystick_hr_filter_cfg.y_mode,
+                                      joystick_hr_filter_cfg.y_ema_shift,
+                                      pos->y);
+}
+
+uint8_t joystick_hr_is_centered(uint16_t x, uint16_t y)
+{
+    return (x >= CENTER_HR_X_MIN && x <= CENTER_HR_X_MAX &&
+            y >= CENTER_HR_Y_MIN && y <= CENTER_HR_Y_MAX) ? 1 : 0;
+}
+
+joystick_direction_t joystick_hr_get_direction(uint16_t x, uint16_t y)
+{
+    /* The 8-bit threshold cascade, comparison for comparison, on the
+     * compile-time scaled thresholds — so both classifiers agree at
+     * every position (see JOYSTICK_HR_SCALE / _SCALE_HI) */
+
+    /* Check center zone first (dead zone) */
+    if (joystick_hr_is_centered(x, y)) {
+        return DIR_CENTER;
+    }
+
+    /* Check diagonal directions (corners) */
+    /* North-East: high X, high Y */
+    if (x > JOYSTICK_HR_SCALE_HI(DIAGONAL_THRESHOLD_HIGH) &&
+        y > JOYSTICK_HR_SCALE_HI(DIAGONAL_THRESHOLD_HIGH)) {
+        return DIR_NORTH_EAST;
+    }
+
+    /* North-West: low X, high Y */
+    if (x < JOYSTICK_HR_SCALE(DIAGONAL_THRESHOLD_LOW) &&
+        y > JOYSTICK_HR_SCALE_HI(ADC_MAX - DIAGONAL_THRESHOLD_LOW)) {
+        return DIR_NORTH_WEST;
+    }
+
+    /* South-East: high X, low Y */
+    if (x > JOYSTICK_HR_SCALE_HI(DIAGONAL_THRESHOLD_HIGH) &&
+        y < JOYSTICK_HR_SCALE(DIAGONAL_THRESHOLD_LOW)) {
+        return DIR_SOUTH_EAST;
+    }
+
+    /* South-West: low X, low Y */
+    if (x < JOYSTICK_HR_SCALE(DIAGONAL_THRESHOLD_LOW) &&
+        y < JOYSTICK_HR_SCALE(DIAGONAL_THRESHOLD_LOW)) {
+        return DIR_SOUTH_WEST;
+    }
+
+    /* Check cardinal directions */
+    /* North: high Y, X near center */
+    if (y >= THRESHOLD_HR_NORTH_Y && x >= CENTER_HR_X_MIN &&
+        x <= CENTER_HR_X_MAX) {
+        return DIR_NORTH;
+    }
+
+    /* South: low Y, X near center */
+    if (y <= THRESHOLD_HR_SOUTH_Y && x >= CENTER_HR_X_MIN &&
+        x <= CENTER_HR_X_MAX) {
+        return DIR_SOUTH;
+    }
+
+    /* East: high X, Y near center */
+    if (x >= THRESHOLD_HR_EAST_X && y >= CENTER_HR_Y_MIN &&
+        y <= CENTER_HR_X_MAX) {
+        return DIR_EAST;
+    }
+
+    /* West: low X, Y near center */
+    if (x <= THRESHOLD_HR_WEST_X && y >= CENTER_HR_Y_MIN &&
+        y <= CENTER_HR_X_MAX) {
+        return DIR_WEST;
+    }
+
+    /* If no specific direction matched, return center */
+    return DIR_CENTER;
+}
+
+void joystick_hr_to_position(const joystick_hr_position_t *hr,
+                             joystick_position_t *pos)
+{
+    pos->x = (uint8_t)(hr->x >> 2);
+    pos->y = (uint8_t)(hr->y >> 2);
+}
+
+/**
+ * @brief Advance one velocity EMA by a new sample delta
+ *
+ * The delta is clamped to +/-511 counts/sample (half scale, far beyond
+ * any real stick slew) so the 10.6 accumulator can never overflow
+ * int16.
+ */
+static int16_t joystick_hr_vel_step(int16_t vel, int16_t delta)
+{
+    if (delta > 511) delta = 511;
+    if (delta < -511) delta = -511;
+
+    /* vel += (delta - vel) / 2^shift, with the delta promoted to 10.6 */
+    return (int16_t)(vel +
+        ((((int32_t)delta << JOYSTICK_HR_FP_SHIFT) - vel) >>
+         JOYSTICK_HR_VELOCITY_SHIFT));
+}
+
+void joystick_hr_track(const joystick_hr_position_t *pos)
+{
+    if (joystick_hr_tracked) {
+        joystick_hr_vel_x = joystick_hr_vel_step(joystick_hr_vel_x,
+            (int16_t)(pos->x - joystick_hr_prev.x));
+        joystick_hr_vel_y = joystick_hr_vel_step(joystick_hr_vel_y,
+            (int16_t)(pos->y - joystick_hr_prev.y));
+    }
+
+    joystick_hr_prev = *pos;
+    joystick_hr_tracked = 1;
+}
+
+int16_t joystick_hr_velocity_x(void)
+{
+    return joystick_hr_vel_x;
+}
+
+int16_t joystick_hr_velocity_y(void)
+{
+    return joystick_hr_vel_y;
+}
@@ -8,6 +8,174 @@
 #include <stdlib.h>
 #include "../include/config.h"
 #include "../include/lcd.h"
+#include "../include/perf.h"
+
+#if LCD_USE_4BIT
+
+#if !LCD_USE_BUSY_FLAG
+#error "4-bit LCD mode requires LCD_USE_BUSY_FLAG (nibbles are paced by the busy flag)"
+#endif
+
+/**
+ * @brief Put one nibble on the upper data pins and strobe enable
+ *
+ * RS/RW must already be set by the caller. The lower half of the data
+ * port is left untouched so other peripherals can share it.
+ */
+static void lcd_put_nibble(uint8_t nibble)
+{
+    LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | (uint8_t)(nibble << 4);
+    LCD_CTRL_PORT |= (1 << LCD_EN_PIN);
+    _delay_us(LCD_ENABLE_PULSE_US);
+    LCD_CTRL_PORT &= ~(1 << LCD_EN_PIN);
+    _delay_us(LCD_ENABLE_PULSE_US);
+}
+
+/**
+ * @brief Wait until the HD44780 busy flag (D7) clears, 4-bit bus
+ *
+ * Each status read is two enable strobes (high then low nibble); both
+ * must always be clocked to keep the nibble phase in sync.
+ */
+static void lcd_wait_busy(void)
+{
+    uint8_t busy;
+
+    /* Release the upper data pins so the LCD can drive them */
+    LCD_DATA_DDR &= 0x0F;
+    LCD_DATA_PORT &= 0x0F;
+
+    /* RS = 0, RW = 1: read busy flag and address counter */
+    LCD_CTRL_PORT &= ~(1 << LCD_RS_PIN);
+    LCD_CTRL_PORT |= (1 << LCD_RW_PIN);
+
+    do {
+        /* High nibble carries the busy flag on D7 */
+        LCD_CTRL_PORT |= (1 << LCD_EN_PIN);
+        _delay_us(LCD_ENABLE_PULSE_US);
+        busy = LCD_DATA_PIN & 0x80;
+        LCD_CTRL_PORT &= ~(1 << LCD_EN_PIN);
+        _delay_us(LCD_ENABLE_PULSE_US);
+
+        /* Low nibble must be clocked out too */
+        LCD_CTRL_PORT |= (1 << LCD_EN_PIN);
+        _delay_us(LCD_ENABLE_PULSE_US);
+        LCD_CTRL_PORT &= ~(1 << LCD_EN_PIN);
+        _delay_us(LCD_ENABLE_PULSE_US);
+    } while (busy);
+
+    /* Reclaim the upper data pins for writing */
+    LCD_CTRL_PORT &= ~(1 << LCD_RW_PIN);
+    LCD_DATA_DDR |= 0xF0;
+}
+
+/**
+ * @brief Write one byte as two back-to-back nibbles
+ *
+ * @param byte Byte to write
+ * @param rs 0 for command register, 1 for data register
+ */
+static void lcd_write(uint8_t byte, uint8_t rs)
+{
+    lcd_wait_busy();
+
+    if (rs) {
+        LCD_CTRL_PORT |= (1 << LCD_RS_PIN);
+    } else {
+        LCD_CTRL_PORT &= ~(1 << LCD_RS_PIN);
+    }
+
+    lcd_put_nibble(byte >> 4);
+    lcd_put_nibble(byte & 0x0F);
+}
+
+void lcd_command(uint8_t cmd)
+{
+    PERF_BEGIN(PERF_ID_LCD_WRITE);
+    lcd_write(cmd, 0);
+    PERF_END(PERF_ID_LCD_WRITE);
+}
+
+void lcd_data(uint8_t data)
+{
+    PERF_BEGIN(PERF_ID_LCD_WRITE);
+    lcd_write(data, 1);
+    PERF_END(PERF_ID_LCD_WRITE);
+}
+
+#elif LCD_USE_BUSY_FLAG
+
+/**
+ * @brief Wait until the HD44780 busy flag (D7) clears
+ *
+ * Temporarily turns the data bus around for reading (RS = 0, RW = 1)
+ * and strobes enable until the controller reports ready, then restores
+ * the bus to output. A write typically completes in ~40 us, so this
+ * replaces the fixed millisecond delays of the slow path.
+ */
+static void lcd_wait_busy(void)
+{
+    uint8_t busy;
+
+    /* Release the data bus so the LCD can drive it */
+    LCD_DATA_DDR = 0x00;
+    LCD_DATA_PORT = 0x00;
+
+    /* RS = 0, RW = 1: read busy flag and address counter */
+    LCD_CTRL_PORT &= ~(1 << LCD_RS_PIN);
+    LCD_CTRL_PORT |= (1 << LCD_RW_PIN);
+
+    do {
+        LCD_CTRL_PORT |= (1 << LCD_EN_PIN);
+        _delay_us(LCD_ENABLE_PULSE_US);
+        busy = LCD_DATA_PIN & 0x80;
+        LCD_CTRL_PORT &= ~(1 << LCD_EN_PIN);
+        _delay_us(LCD_ENABLE_PULSE_US);
+    } while (busy);
+
+    /* Reclaim the bus for writing */
+    LCD_CTRL_PORT &= ~(1 << LCD_RW_PIN);
+    LCD_DATA_DDR = 0xFF;
+}
+
+/**
+ * @brief Write one byte to the LCD after the busy flag clears
+ *
+ * @param byte Byte to write
+ * @param rs 0 for command register, 1 for data register
+ */
+static void lcd_write(uint8_t byte, uint8_t rs)
+{
+    lcd_wait_busy();
+
+    if (rs) {
+        LCD_CTRL_PORT |= (1 << LCD_RS_PIN);
+    } else {
+        LCD_CTRL_PORT &= ~(1 << LCD_RS_PIN);
+    }
+
+    /* Put byte on data port and strobe enable */
+    LCD_DATA_PORT = byte;
+    LCD_CTRL_PORT |= (1 << LCD_EN_PIN);
+    _delay_us(LCD_ENABLE_PULSE_US);
+    LCD_CTRL_PORT &= ~(1 << LCD_EN_PIN);
+}
+
+void lcd_command(uint8_t cmd)
+{
+    PERF_BEGIN(PERF_ID_LCD_WRITE);
+    lcd_write(cmd, 0);
+    PERF_END(PERF_ID_LCD_WRITE);
+}
+
+void lcd_data(uint8_t data)
+{
+    PERF_BEGIN(PERF_ID_LCD_WRITE);
+    lcd_write(data, 1);
+    PERF_END(PERF_ID_LCD_WRITE);
+}
+
+#else /* !LCD_USE_BUSY_FLAG */
 
 /**
  * @brief Generate enable pulse for LCD
@@ -25,13 +193,13 @@ void lcd_command(uint8_t cmd)
     /* RS = 0 for command, RW = 0 for write */
     LCD_CTRL_PORT &= ~(1 << LCD_RS_PIN);
     LCD_CTRL_PORT &= ~(1 << LCD_RW_PIN);
-    
+
     /* Put command on data port */
     LCD_DATA_PORT = cmd;
-    
+
     /* Pulse enable */
     lcd_enable_pulse();
-    
+
     _delay_ms(LCD_COMMAND_DELAY_MS);
 }
 
@@ -40,29 +208,57 @@ void lcd_data(uint8_t data)
     /* RS = 1 for data, RW = 0 for write */
     LCD_CTRL_PORT |= (1 << LCD_RS_PIN);
     LCD_CTRL_PORT &= ~(1 << LCD_RW_PIN);
-    
+
     /* Put data on data port */
     LCD_DATA_PORT = data;
-    
+
     /* Pulse enable */
     lcd_enable_pulse();
-    
+
     _delay_ms(LCD_COMMAND_DELAY_MS);
 }
 
+#endif /* LCD_USE_BUSY_FLAG */
+
 void lcd_init(void)
 {
     /* Configure control pins as outputs */
     LCD_CTRL_DDR |= (1 << LCD_RS_PIN) | (1 << LCD_RW_PIN) | (1 << LCD_EN_PIN);
-    
+
+#if LCD_USE_4BIT
+    /* Only the upper data nibble belongs to the LCD */
+    LCD_DATA_DDR |= 0xF0;
+
+    /* Wait for LCD to power up */
+    _delay_ms(50);
+
+    /* Forced reset by instruction: the controller may be in 8-bit or
+     * an unknown 4-bit nibble phase, and the busy flag cannot be read
+     * yet, so these raw nibbles are paced by delays */
+    LCD_CTRL_PORT &= ~((1 << LCD_RS_PIN) | (1 << LCD_RW_PIN));
+    lcd_put_nibble(0x03);
+    _delay_ms(5);
+    lcd_put_nibble(0x03);
+    _delay_ms(1);
+    lcd_put_nibble(0x03);
+    _delay_ms(1);
+
+    /* Switch to 4-bit bus; from here on commands are busy-flag paced */
+    lcd_put_nibble(0x02);
+    _delay_ms(1);
+
+    /* Function Set (4-bit, 2 lines, 5x7) */
+    lcd_command(LCD_CMD_FUNCTION_SET_4BIT);
+#else
     /* Configure data port as output */
     LCD_DATA_DDR = 0xFF;
-    
+
     /* Wait for LCD to power up */
     _delay_ms(50);
-    
+
     /* Initialize LCD: Function Set (8-bit, 2 lines, 5x7) */
     lcd_command(LCD_CMD_FUNCTION_SET);
+#endif
     _delay_ms(LCD_COMMAND_DELAY_MS);
     
     /* Display ON, Cursor ON */
@@ -81,6 +277,152 @@ void lcd_init(void)
     lcd_command(LCD_CMD_LINE1);
 }
 
+/* Asynchronous init state machine. Delays between init steps are
+ * waited out across lcd_init_poll() calls instead of inside _delay_ms,
+ * so the foreground (ADC warm-up, joystick_init(), calibration load)
+ * runs in parallel with the controller's power-up sequence. */
+enum {
+    LCD_INIT_IDLE = 0,      /* lcd_init_start() not called yet */
+    LCD_INIT_POWERUP,       /* waiting out the 50 ms power-on delay */
+#if LCD_USE_4BIT
+    LCD_INIT_RESET_B,       /* forced-reset nibbles, delay-paced */
+    LCD_INIT_RESET_C,
+    LCD_INIT_BUS4,          /* switch to the 4-bit bus */
+#endif
+    LCD_INIT_FUNCTION,      /* function set */
+    LCD_INIT_DISPLAY,       /* display on */
+    LCD_INIT_CLEAR,         /* clear display */
+    LCD_INIT_ENTRY,         /* entry mode */
+    LCD_INIT_HOME,          /* cursor home */
+    LCD_INIT_COMPLETE
+};
+
+static uint8_t lcd_init_state;
+static uint8_t lcd_init_wait;   /* ms left before the next step */
+
+/* Settle time between commands: zero when the busy flag paces writes */
+#if LCD_USE_BUSY_FLAG
+#define LCD_INIT_STEP_WAIT_MS   0
+#else
+#define LCD_INIT_STEP_WAIT_MS   LCD_COMMAND_DELAY_MS
+#endif
+
+void lcd_init_start(void)
+{
+    /* Configure control pins as outputs */
+    LCD_CTRL_DDR |= (1 << LCD_RS_PIN) | (1 << LCD_RW_PIN) | (1 << LCD_EN_PIN);
+
+#if LCD_USE_4BIT
+    /* Only the upper data nibble belongs to the LCD */
+    LCD_DATA_DDR |= 0xF0;
+#else
+    /* Configure data port as output */
+    LCD_DATA_DDR = 0xFF;
+#endif
+
+    lcd_init_wait = 50;     /* power-on delay, consumed across polls */
+    lcd_init_state = LCD_INIT_POWERUP;
+}
+
+uint8_t lcd_init_poll(uint8_t elapsed_ms)
+{
+    if (lcd_init_state == LCD_INIT_COMPLETE) {
+        return 1;
+    }
+    if (lcd_init_state == LCD_INIT_IDLE) {
+        return 0;
+    }
+
+    /* Burn down the current step's delay before advancing */
+    if (lcd_init_wait != 0) {
+        if (elapsed_ms < lcd_init_wait) {
+            lcd_init_wait -= elapsed_ms;
+            return 0;
+        }
+        lcd_init_wait = 0;
+    }
+
+    switch (lcd_init_state) {
+#if LCD_USE_4BIT
+    case LCD_INIT_POWERUP:
+        /* Forced reset by instruction: the busy flag cannot be read
+         * yet, so these raw nibbles are paced by the poll delays */
+        LCD_CTRL_PORT &= ~((1 << LCD_RS_PIN) | (1 << LCD_RW_PIN));
+        lcd_put_nibble(0x03);
+        lcd_init_wait = 5;
+        lcd_init_state = LCD_INIT_RESET_B;
+        break;
+
+    case LCD_INIT_RESET_B:
+        lcd_put_nibble(0x03);
+        lcd_init_wait = 1;
+        lcd_init_state = LCD_INIT_RESET_C;
+        break;
+
+    case LCD_INIT_RESET_C:
+        lcd_put_nibble(0x03);
+        lcd_init_wait = 1;
+        lcd_init_state = LCD_INIT_BUS4;
+        break;
+
+    case LCD_INIT_BUS4:
+        lcd_put_nibble(0x02);
+        lcd_init_wait = 1;
+        lcd_init_state = LCD_INIT_FUNCTION;
+        break;
+
+    case LCD_INIT_FUNCTION:
+        lcd_command(LCD_CMD_FUNCTION_SET_4BIT);
+        lcd_init_wait = LCD_INIT_STEP_WAIT_MS;
+        lcd_init_state = LCD_INIT_DISPLAY;
+        break;
+#else
+    case LCD_INIT_POWERUP:
+    case LCD_INIT_FUNCTION:
+        lcd_command(LCD_CMD_FUNCTION_SET);
+        lcd_init_wait = LCD_INIT_STEP_WAIT_MS;
+        lcd_init_state = LCD_INIT_DISPLAY;
+        break;
+#endif
+
+    case LCD_INIT_DISPLAY:
+        lcd_command(LCD_CMD_DISPLAY_ON);
+        lcd_init_wait = LCD_INIT_STEP_WAIT_MS;
+        lcd_init_state = LCD_INIT_CLEAR;
+        break;
+
+    case LCD_INIT_CLEAR:
+        lcd_command(LCD_CMD_CLEAR);
+        /* Clear needs ~1.5 ms even with busy-flag pacing; waiting it
+         * out here keeps the next poll from spinning on busy */
+        lcd_init_wait = (LCD_INIT_STEP_WAIT_MS > 2) ?
+                        LCD_INIT_STEP_WAIT_MS : 2;
+        lcd_init_state = LCD_INIT_ENTRY;
+        break;
+
+    case LCD_INIT_ENTRY:
+        lcd_command(LCD_CMD_ENTRY_MODE);
+        lcd_init_wait = LCD_INIT_STEP_WAIT_MS;
+        lcd_init_state = LCD_INIT_HOME;
+        break;
+
+    case LCD_INIT_HOME:
+        lcd_command(LCD_CMD_LINE1);
+        lcd_init_state = LCD_INIT_COMPLETE;
+        break;
+
+    default:
+        break;
+    }
+
+    return lcd_init_state == LCD_INIT_COMPLETE;
+}
+
+uint8_t lcd_init_done(void)
+{
+    return lcd_init_state == LCD_INIT_COMPLETE;
+}
+
 void lcd_clear(void)
 {
     lcd_command(LCD_CMD_CLEAR);
@@ -107,6 +449,15 @@ void lcd_print(const char *str)
     }
 }
 
+void lcd_print_P(PGM_P str)
+{
+    char c;
+
+    while ((c = (char)pgm_read_byte(str++)) != '\0') {
+        lcd_data((uint8_t)c);
+    }
+}
+
 void lcd_putc(char c)
 {
     lcd_data(c);
@@ -118,3 +469,44 @@ void lcd_print_int(int16_t value)
     itoa(value, buffer, 10);
     lcd_print(buffer);
 }
+
+void lcd_print_u8_3(uint8_t value)
+{
+    uint8_t digit;
+
+    /* Digits by repeated subtraction: no div/mod, no libc, and the
+     * output is always exactly three characters wide */
+    digit = '0';
+    while (value >= 100) {
+        value -= 100;
+        digit++;
+    }
+    lcd_data(digit);
+
+    digit = '0';
+    while (value >= 10) {
+        value -= 10;
+        digit++;
+    }
+    lcd_data(digit);
+
+    lcd_data((uint8_t)('0' + value));
+}
+
+void lcd_print_u16_5(uint16_t value)
+{
+    static const uint16_t place[4] = { 10000, 1000, 100, 10 };
+    uint8_t i;
+    uint8_t digit;
+
+    for (i = 0; i < 4; i++) {
+        digit = '0';
+        while (value >= place[i]) {
+            value -= place[i];
+            digit++;
+        }
+        lcd_data(digit);
+    }
+
+    lcd_data((uint8_t)('0' + value));
+}
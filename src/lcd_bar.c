@@ -0,0 +1,85 @@
+/**
+ * @file lcd_bar.c
+ * @brief CGRAM Bargraph Widget Implementation
+ */
+
+#include "../include/config.h"
+#include "../include/lcd.h"
+#include "../include/lcd_bar.h"
+
+/**
+ * @brief Glyph a cell shows at a given bar fill
+ *
+ * @param level Bar fill in fifths of a cell
+ * @param cell Cell index within the bar
+ * @return uint8_t Character code: ' ' for empty, CGRAM 0-4 otherwise
+ */
+static uint8_t lcd_bar_glyph(uint8_t level, uint8_t cell)
+{
+    uint8_t base = (uint8_t)(cell * 5);
+
+    if (level <= base) {
+        return ' ';
+    }
+    if (level - base >= 5) {
+        return 4;               /* full block glyph */
+    }
+    return (uint8_t)(level - base - 1);
+}
+
+void lcd_bar_setup(void)
+{
+    uint8_t glyph, line, pattern;
+
+    for (glyph = 0; glyph < 5; glyph++) {
+        lcd_command((uint8_t)(LCD_CMD_SET_CGRAM | (glyph << 3)));
+
+        /* glyph + 1 columns filled from the left of the 5-dot row */
+        pattern = (uint8_t)((((1 << (glyph + 1)) - 1) << (4 - glyph)) & 0x1F);
+        for (line = 0; line < 8; line++) {
+            lcd_data(pattern);
+        }
+    }
+}
+
+void lcd_bar_init(lcd_bar_t *bar, uint8_t row, uint8_t col, uint8_t width)
+{
+    uint8_t i;
+
+    bar->row = row;
+    bar->col = col;
+    bar->width = width;
+    bar->level = 0;
+
+    /* Paint the region blank once; the cursor auto-increments */
+    lcd_set_cursor(row, col);
+    for (i = 0; i < width; i++) {
+        lcd_data(' ');
+    }
+}
+
+void lcd_bar_update(lcd_bar_t *bar, uint8_t value)
+{
+    uint8_t steps = (uint8_t)(bar->width * 5);
+    uint8_t new_level, i, old_glyph, new_glyph;
+
+    /* Scale 0-255 onto 0..steps without a division */
+    new_level = (uint8_t)(((uint16_t)value * steps + 255) >> 8);
+
+    if (new_level == bar->level) {
+        return;
+    }
+
+    /* Rewrite only cells whose glyph changed — for a one-step change
+     * that is the single boundary cell */
+    for (i = 0; i < bar->width; i++) {
+        old_glyph = lcd_bar_glyph(bar->level, i);
+        new_glyph = lcd_bar_glyph(new_level, i);
+        if (old_glyph != new_glyph) {
+            lcd_set_cursor(bar->row, (uint8_t)(bar->col + i));
+            lcd_data(new_glyph);
+        }
+    }
+
+    bar->level = new_level;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file lcd_fb.c
+ * @brief Shadow Frame Buffer Implementation with Dirty-Cell Diffing
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/config.h"
+#include "../include/lcd.h"
+#include "../include/lcd_fb.h"
+
+/* Pending frame drawn by the application */
+static char lcd_fb_back[LCD_FB_ROWS][LCD_FB_COLS];
+
+/* Last frame actually sent to the panel */
+static char lcd_fb_front[LCD_FB_ROWS][LCD_FB_COLS];
+
+void lcd_fb_init(void)
+{
+    memset(lcd_fb_back, ' ', sizeof(lcd_fb_back));
+    memset(lcd_fb_front, ' ', sizeof(lcd_fb_front));
+    lcd_clear();
+}
+
+void lcd_fb_clear(void)
+{
+    memset(lcd_fb_back, ' ', sizeof(lcd_fb_back));
+}
+
+void lcd_fb_print(uint8_t row, uint8_t col, const char *str)
+{
+    if (row >= LCD_FB_ROWS) {
+        return;
+    }
+
+    while (*str && col < LCD_FB_COLS) {
+        lcd_fb_back[row][col++] = *str++;
+    }
+}
+
+void lcd_fb_printf(uint8_t row, uint8_t col, const char *fmt, ...)
+{
+    char buffer[LCD_FB_COLS + 1];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    lcd_fb_print(row, col, buffer);
+}
+
+void lcd_fb_flush(void)
+{
+    uint8_t row, col;
+    uint8_t cursor_valid;
+
+    for (row = 0; row < LCD_FB_ROWS; row++) {
+        /* Cursor position is only known once we set it; sequential data
+         * writes auto-increment it, so a run of dirty cells needs just
+         * one cursor command */
+        cursor_valid = 0;
+
+        for (col = 0; col < LCD_FB_COLS; col++) {
+            if (lcd_fb_back[row][col] != lcd_fb_front[row][col]) {
+                if (!cursor_valid) {
+                    lcd_set_cursor(row, col);
+                    cursor_valid = 1;
+                }
+                lcd_data((uint8_t)lcd_fb_back[row][col]);
+                lcd_fb_front[row][col] = lcd_fb_back[row][col];
+            } else {
+                cursor_valid = 0;
+            }
+        }
+    }
+}
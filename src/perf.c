@@ -0,0 +1,112 @@
+/**
+ * @file perf.c
+ * @brief Hot-Path Timing Instrumentation Implementation
+ */
+
+#include "../include/config.h"
+#include "../include/perf.h"
+
+#if PERF_ENABLE
+
+#include <avr/io.h>
+#include "../include/lcd_fb.h"
+#include "../include/uart.h"
+
+/* Per-probe accumulators. A probe is only ever touched from one
+ * context (see perf.h), so plain non-atomic updates are safe. */
+typedef struct {
+    uint8_t start;          /* TCNT0 at section entry */
+    uint8_t min;
+    uint8_t max;
+    uint32_t sum;
+    uint16_t count;
+} perf_counter_t;
+
+static perf_counter_t perf_counters[PERF_ID_COUNT];
+
+/* Three-character labels for the LCD overlay, indexed by probe id */
+static const char perf_labels[PERF_ID_COUNT][4] = {
+    "adc", "dir", "lcd"
+};
+
+void perf_init(void)
+{
+    uint8_t id;
+
+    /* Timer0 free-running at F_CPU/8: 0.5 us per tick at 16 MHz,
+     * wrapping after 127.5 us — longer than any probed section */
+    TCCR0 = (1 << CS01);
+
+    for (id = 0; id < PERF_ID_COUNT; id++) {
+        perf_reset(id);
+    }
+}
+
+void perf_reset(uint8_t id)
+{
+    perf_counters[id].min = 0xFF;
+    perf_counters[id].max = 0;
+    perf_counters[id].sum = 0;
+    perf_counters[id].count = 0;
+}
+
+void perf_begin(uint8_t id)
+{
+    perf_counters[id].start = TCNT0;
+}
+
+void perf_end(uint8_t id)
+{
+    perf_counter_t *c = &perf_counters[id];
+
+    /* Free-running counter: an unsigned subtract spans the wrap */
+    uint8_t elapsed = (uint8_t)(TCNT0 - c->start);
+
+    if (elapsed < c->min) c->min = elapsed;
+    if (elapsed > c->max) c->max = elapsed;
+    c->sum += elapsed;
+    c->count++;
+}
+
+void perf_get(uint8_t id, perf_stats_t *stats)
+{
+    const perf_counter_t *c = &perf_counters[id];
+
+    stats->min = (c->count != 0) ? c->min : 0;
+    stats->avg = (c->count != 0) ? (uint8_t)(c->sum / c->count) : 0;
+    stats->max = c->max;
+    stats->count = c->count;
+}
+
+void perf_report_lcd(uint8_t id)
+{
+    perf_stats_t stats;
+
+    perf_get(id, &stats);
+
+    /* The examples leave line 2 unused; claim it for diagnostics */
+    lcd_fb_printf(1, 0, "%s %3u/%3u/%3u", perf_labels[id],
+                  stats.min, stats.avg, stats.max);
+    lcd_fb_flush();
+}
+
+void perf_report_uart(uint8_t id)
+{
+    perf_stats_t stats;
+    uint8_t frame[5];
+
+    perf_get(id, &stats);
+
+    frame[0] = PERF_TELEMETRY_SYNC;
+    frame[1] = id;
+    frame[2] = stats.min;
+    frame[3] = stats.avg;
+    frame[4] = stats.max;
+
+    /* All-or-nothing so the receiver never sees a torn frame */
+    if (uart_tx_free() >= sizeof(frame)) {
+        uart_write(frame, sizeof(frame));
+    }
+}
+
+#endif /* PERF_ENABLE */
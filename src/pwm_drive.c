@@ -0,0 +1,105 @@
+/**
+ * @file pwm_drive.c
+ * @brief Zero-Lag PWM Drive Stage Implementation
+ */
+
+#include <avr/io.h>
+#include "../include/config.h"
+#include "../include/adc.h"
+#include "../include/calibration.h"
+#include "../include/pwm_drive.h"
+
+#if PWM_DRIVE_ENABLE
+
+/* Position-to-duty transfer table; one load per sample in the ISR */
+static uint8_t pwm_table[256];
+
+/* Last duty written per axis, for diagnostics */
+static volatile uint8_t pwm_duty_x;
+static volatile uint8_t pwm_duty_y;
+
+/**
+ * @brief ADC sample hook: push fresh samples straight into the OCRs
+ *
+ * Runs in the conversion-complete interrupt; cost is the calibration
+ * remap plus one table load and one register write.
+ */
+static void pwm_drive_hook(uint8_t channel, uint8_t sample)
+{
+    uint8_t duty;
+
+    if (channel == JOYSTICK_X_CHANNEL) {
+        duty = pwm_table[joystick_cal_apply_x(sample)];
+        OCR1A = duty;
+        pwm_duty_x = duty;
+    } else if (channel == JOYSTICK_Y_CHANNEL) {
+        duty = pwm_table[joystick_cal_apply_y(sample)];
+        OCR1B = duty;
+        pwm_duty_y = duty;
+    }
+}
+
+void pwm_drive_init(pwm_curve_t curve, uint8_t expo_strength)
+{
+    uint16_t i;
+
+    /* Build the transfer table: deflection magnitude from center,
+     * optionally blended with a cubic for expo feel, doubled to span
+     * the full 8-bit duty range */
+    for (i = 0; i < 256; i++) {
+        int16_t centered = (int16_t)i - 128;
+        uint8_t mag = (uint8_t)((centered < 0) ? -centered : centered);
+        uint8_t shaped;
+
+        if (mag > 127) {
+            mag = 127;
+        }
+
+        if (curve == PWM_CURVE_EXPO) {
+            /* cubic term normalized back to 0-127 */
+            uint8_t cubic = (uint8_t)(((uint32_t)mag * mag * mag) /
+                                      (127UL * 127UL));
+            shaped = (uint8_t)(((uint16_t)mag * (255 - expo_strength) +
+                                (uint16_t)cubic * expo_strength) / 255);
+        } else {
+            shaped = mag;
+        }
+
+        pwm_table[i] = (uint8_t)(shaped << 1);
+    }
+
+    /* OC1A/OC1B pins as outputs */
+    DDRD |= (1 << PD5) | (1 << PD4);
+
+    /* Timer1: 8-bit fast PWM, non-inverting on both channels,
+     * /8 prescaler (~7.8 kHz at 16 MHz) */
+    OCR1A = 0;
+    OCR1B = 0;
+    TCCR1A = (1 << COM1A1) | (1 << COM1B1) | (1 << WGM10);
+    TCCR1B = (1 << WGM12) | (1 << CS11);
+
+    adc_set_sample_hook(pwm_drive_hook);
+}
+
+void pwm_drive_stop(void)
+{
+    adc_set_sample_hook(0);
+
+    /* Stop the timer and disconnect the compare outputs */
+    TCCR1A = 0;
+    TCCR1B = 0;
+    OCR1A = 0;
+    OCR1B = 0;
+}
+
+uint8_t pwm_drive_duty_x(void)
+{
+    return pwm_duty_x;
+}
+
+uint8_t pwm_drive_duty_y(void)
+{
+    return pwm_duty_y;
+}
+
+#endif /* PWM_DRIVE_ENABLE */
@@ -0,0 +1,126 @@
+/**
+ * @file scheduler.c
+ * @brief Timer1 CTC Sampling Scheduler Implementation
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include "../include/config.h"
+#include "../include/scheduler.h"
+
+/* Registered tasks, dispatched in registration order. countdown is
+ * decremented every tick; the task runs when it reaches zero. */
+typedef struct {
+    scheduler_callback_t callback;
+    uint16_t period;        /* ticks between runs */
+    uint16_t countdown;     /* ticks until the next run */
+} scheduler_task_t;
+
+static scheduler_task_t scheduler_tasks[SCHEDULER_MAX_TASKS];
+static uint8_t scheduler_task_count;
+
+/* Set by the compare-match ISR, consumed by scheduler_run() */
+static volatile uint8_t scheduler_tick_pending;
+
+/* Free-running tick counter for timekeeping */
+static volatile uint16_t scheduler_tick_count;
+
+void scheduler_init(uint16_t rate_hz)
+{
+    /* CTC mode, TOP = OCR1A, prescaler /64 */
+    TCCR1A = 0;
+    TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10);
+
+    /* Compare value for the requested tick rate */
+    OCR1A = (uint16_t)((F_CPU / 64UL) / rate_hz - 1);
+    TCNT1 = 0;
+
+    /* Enable compare-match A interrupt */
+    TIMSK |= (1 << OCIE1A);
+}
+
+uint8_t scheduler_add(scheduler_callback_t callback)
+{
+    return scheduler_add_periodic(callback, 1);
+}
+
+uint8_t scheduler_add_periodic(scheduler_callback_t callback,
+                               uint16_t period_ticks)
+{
+    if (scheduler_task_count >= SCHEDULER_MAX_TASKS || period_ticks == 0) {
+        return 0;
+    }
+
+    scheduler_tasks[scheduler_task_count].callback = callback;
+    scheduler_tasks[scheduler_task_count].period = period_ticks;
+    scheduler_tasks[scheduler_task_count].countdown = period_ticks;
+    scheduler_task_count++;
+
+    return 1;
+}
+
+uint16_t scheduler_ticks(void)
+{
+    uint16_t ticks;
+
+    /* 16-bit read must not be torn by the tick interrupt */
+    cli();
+    ticks = scheduler_tick_count;
+    sei();
+
+    return ticks;
+}
+
+void scheduler_run(void)
+{
+    uint8_t i;
+
+    /* Idle sleep keeps clkIO alive, so Timer1 still ticks and the
+     * free-running ADC scan keeps filling its sample buffers.
+     * (ADC noise-reduction sleep would stop Timer1.) */
+    set_sleep_mode(SLEEP_MODE_IDLE);
+
+    while (1) {
+        /* Canonical avr-libc idle sequence: test the flag with
+         * interrupts off and rely on sei()'s guarantee that the
+         * instruction after it (the sleep) executes before any pending
+         * interrupt is served. Testing with interrupts on would leave
+         * a window where a tick lands between the test and the sleep
+         * and is slept through, collapsing two ticks into one
+         * dispatch. */
+        cli();
+        if (!scheduler_tick_pending) {
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+            continue;   /* re-test: any interrupt can end the sleep */
+        }
+        scheduler_tick_pending = 0;
+        sei();
+
+        for (i = 0; i < scheduler_task_count; i++) {
+            scheduler_tasks[i].countdown--;
+            if (scheduler_tasks[i].countdown == 0) {
+                scheduler_tasks[i].countdown = scheduler_tasks[i].period;
+                scheduler_tasks[i].callback();
+            }
+        }
+
+        /* Service the watchdog at one deterministic point: every task
+         * due this tick ran to completion. A no-op when the WDT is
+         * disabled; with it enabled, a stuck task means a reset. */
+        wdt_reset();
+    }
+}
+
+/**
+ * @brief Timer1 compare-match interrupt: mark a tick as due
+ */
+ISR(TIMER1_COMPA_vect)
+{
+    scheduler_tick_pending = 1;
+    scheduler_tick_count++;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file uart.c
+ * @brief Interrupt-Driven UART Transmitter Implementation
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "../include/config.h"
+#include "../include/uart.h"
+
+#define UART_TX_BUFFER_MASK     (UART_TX_BUFFER_SIZE - 1)
+
+/* TX ring buffer: main context produces, the UDRE interrupt consumes.
+ * Free-running uint8_t indices keep each side's updates atomic. */
+static uint8_t uart_tx_buffer[UART_TX_BUFFER_SIZE];
+static volatile uint8_t uart_tx_head;
+static volatile uint8_t uart_tx_tail;
+
+void uart_init(void)
+{
+    /* Double-speed mode halves the divisor granularity: at 16 MHz and
+     * 115200 baud the rate error drops to about 2% */
+    uint16_t ubrr = (uint16_t)(F_CPU / 8UL / UART_BAUD - 1);
+
+    UCSRA = (1 << U2X);
+    UBRRH = (uint8_t)(ubrr >> 8);
+    UBRRL = (uint8_t)ubrr;
+
+    /* Enable transmitter; 8 data bits, no parity, 1 stop bit */
+    UCSRB = (1 << TXEN);
+    UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);
+}
+
+uint8_t uart_write_byte(uint8_t byte)
+{
+    uint8_t head = uart_tx_head;
+
+    if ((uint8_t)(head - uart_tx_tail) >= UART_TX_BUFFER_SIZE) {
+        return 0;  /* full: drop rather than block */
+    }
+
+    uart_tx_buffer[head & UART_TX_BUFFER_MASK] = byte;
+    uart_tx_head = head + 1;
+
+    /* Kick the drain interrupt (no-op if already enabled) */
+    UCSRB |= (1 << UDRIE);
+
+    return 1;
+}
+
+uint8_t uart_write(const uint8_t *data, uint8_t len)
+{
+    uint8_t written = 0;
+
+    while (written < len && uart_write_byte(data[written])) {
+        written++;
+    }
+    return written;
+}
+
+uint8_t uart_tx_free(void)
+{
+    return (uint8_t)(UART_TX_BUFFER_SIZE -
+                     (uint8_t)(uart_tx_head - uart_tx_tail));
+}
+
+uint8_t uart_send_telemetry(uint8_t x, uint8_t y, uint8_t direction,
+                            uint8_t flags)
+{
+    /* All-or-nothing so the receiver never sees a torn frame */
+    if (uart_tx_free() < 4) {
+        return 0;
+    }
+
+    uart_write_byte(UART_TELEMETRY_SYNC);
+    uart_write_byte(x);
+    uart_write_byte(y);
+    uart_write_byte((uint8_t)((flags << 4) | (direction & 0x0F)));
+
+    return 1;
+}
+
+/**
+ * @brief Data-register-empty interrupt: feed the next queued byte
+ *
+ * Disables itself when the ring runs dry so the vector stops firing.
+ */
+ISR(USART_UDRE_vect)
+{
+    uint8_t tail = uart_tx_tail;
+
+    if (tail == uart_tx_head) {
+        UCSRB &= ~(1 << UDRIE);
+        return;
+    }
+
+    UDR = uart_tx_buffer[tail & UART_TX_BUFFER_MASK];
+    uart_tx_tail = tail + 1;
+}
@@ -159,3 +159,72 @@ class JoystickLogic:
             "direction_name": self.direction_to_string(direction),
             "is_centered": self.is_centered(x, y),
         }
+
+
+class JoystickLUT:
+    """
+    Lookup-table direction classifier mirroring joystick_lut_init() in C.
+
+    Builds per-axis zone tables from the threshold comparisons plus a
+    zone-pair combine table, so get_direction() becomes two table loads
+    and one combine with no branches.
+    """
+
+    def __init__(self, logic: JoystickLogic):
+        """
+        Build the zone tables from a reference JoystickLogic instance.
+
+        Args:
+            logic: Reference classifier used as the oracle
+        """
+        self.logic = logic
+        cfg = logic.config
+
+        def x_mask(x):
+            """Bitmask of every x-axis comparison used by the cascade."""
+            return ((x > cfg.DIAGONAL_THRESHOLD_HIGH) |
+                    ((x < cfg.DIAGONAL_THRESHOLD_LOW) << 1) |
+                    ((x >= cfg.CENTER_X_MIN) << 2) |
+                    ((x <= cfg.CENTER_X_MAX) << 3) |
+                    ((x >= cfg.THRESHOLD_EAST_X) << 4) |
+                    ((x <= cfg.THRESHOLD_WEST_X) << 5))
+
+        def y_mask(y):
+            """Bitmask of every y-axis comparison used by the cascade."""
+            return ((y > cfg.DIAGONAL_THRESHOLD_HIGH) |
+                    ((y > cfg.ADC_MAX - cfg.DIAGONAL_THRESHOLD_LOW) << 1) |
+                    ((y < cfg.DIAGONAL_THRESHOLD_LOW) << 2) |
+                    ((y >= cfg.THRESHOLD_NORTH_Y) << 3) |
+                    ((y <= cfg.THRESHOLD_SOUTH_Y) << 4) |
+                    ((y >= cfg.CENTER_Y_MIN) << 5) |
+                    ((y <= cfg.CENTER_Y_MAX) << 6) |
+                    ((y <= cfg.CENTER_X_MAX) << 7))
+
+        def build_zones(mask_fn):
+            """Assign a new zone id wherever the comparison mask changes."""
+            zone_table, representatives, prev = [], [], None
+            for value in range(256):
+                mask = mask_fn(value)
+                if value == 0 or mask != prev:
+                    representatives.append(value)
+                    prev = mask
+                zone_table.append(len(representatives) - 1)
+            return zone_table, representatives
+
+        self.x_zone, x_rep = build_zones(x_mask)
+        self.y_zone, y_rep = build_zones(y_mask)
+        self.zone_dir = [[logic.get_direction(xr, yr) for yr in y_rep]
+                         for xr in x_rep]
+
+    def get_direction(self, x: int, y: int) -> Direction:
+        """
+        Branch-free direction lookup.
+
+        Args:
+            x: X-axis value (0-255)
+            y: Y-axis value (0-255)
+
+        Returns:
+            Detected direction (identical to JoystickLogic.get_direction)
+        """
+        return self.zone_dir[self.x_zone[x]][self.y_zone[y]]
@@ -247,3 +247,23 @@ class TestNoiseAndJitter:
         
         # At least half should register as North
         assert north_count >= len(readings_near_threshold) // 2
+
+
+class TestLookupTableClassifier:
+    """Tests for the branch-free lookup-table classifier."""
+
+    def test_lut_matches_cascade_exhaustively(self, direction_detector):
+        """LUT result must equal the cascade for every (x, y) pair."""
+        from joystick_logic import JoystickLUT
+        lut = JoystickLUT(direction_detector)
+        for x in range(256):
+            for y in range(256):
+                assert lut.get_direction(x, y) == \
+                    direction_detector.get_direction(x, y)
+
+    def test_lut_zone_counts_within_bounds(self, direction_detector):
+        """Zone counts must fit the C-side table bounds (8 x, 10 y)."""
+        from joystick_logic import JoystickLUT
+        lut = JoystickLUT(direction_detector)
+        assert max(lut.x_zone) + 1 <= 8
+        assert max(lut.y_zone) + 1 <= 10
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+Classifier generator for the joystick direction hot path.
+
+Reads the zone thresholds from include/config.h and emits a specialized
+joystick_classify_gen() as a generated header: the center (statistically
+common) case is tested first, and every two-sided range check is folded
+into a single unsigned subtract-and-compare. The emitted decision order
+matches the generic cascade in src/joystick.c, so results are identical
+for any threshold set.
+
+Usage:
+    python3 tools/generate_classifier.py include/config.h <output.h>
+
+Invoked from the Makefile via `make gen` / GEN_CLASSIFIER=1.
+"""
+
+import re
+import sys
+
+REQUIRED = [
+    "ADC_MAX",
+    "THRESHOLD_NORTH_Y", "THRESHOLD_SOUTH_Y",
+    "THRESHOLD_EAST_X", "THRESHOLD_WEST_X",
+    "CENTER_X_MIN", "CENTER_X_MAX", "CENTER_Y_MIN", "CENTER_Y_MAX",
+    "DIAGONAL_THRESHOLD_HIGH", "DIAGONAL_THRESHOLD_LOW",
+]
+
+
+def parse_config(path):
+    """Extract the numeric threshold macros from config.h."""
+    values = {}
+    pattern = re.compile(r"^\s*#define\s+(\w+)\s+(\d+)")
+    with open(path) as config:
+        for line in config:
+            match = pattern.match(line)
+            if match and match.group(1) in REQUIRED:
+                values[match.group(1)] = int(match.group(2))
+    missing = [name for name in REQUIRED if name not in values]
+    if missing:
+        sys.exit("generate_classifier: missing in %s: %s"
+                 % (path, ", ".join(missing)))
+    return values
+
+
+def in_range(var, lo, hi):
+    """Fold lo <= var <= hi into one unsigned subtract-and-compare."""
+    if lo == 0:
+        return "%s <= %du" % (var, hi)
+    return "(uint8_t)(%s - %du) <= %du" % (var, lo, hi - lo)
+
+
+def generate(cfg):
+    """Emit the specialized classifier body."""
+    checks = [
+        # (condition, direction) in the same order as the generic cascade
+        ("%s && %s" % (in_range("x", cfg["CENTER_X_MIN"], cfg["CENTER_X_MAX"]),
+                       in_range("y", cfg["CENTER_Y_MIN"], cfg["CENTER_Y_MAX"])),
+         "DIR_CENTER"),
+        ("x > %du && y > %du" % (cfg["DIAGONAL_THRESHOLD_HIGH"],
+                                 cfg["DIAGONAL_THRESHOLD_HIGH"]),
+         "DIR_NORTH_EAST"),
+        ("x < %du && y > %du" % (cfg["DIAGONAL_THRESHOLD_LOW"],
+                                 cfg["ADC_MAX"] - cfg["DIAGONAL_THRESHOLD_LOW"]),
+         "DIR_NORTH_WEST"),
+        ("x > %du && y < %du" % (cfg["DIAGONAL_THRESHOLD_HIGH"],
+                                 cfg["DIAGONAL_THRESHOLD_LOW"]),
+         "DIR_SOUTH_EAST"),
+        ("x < %du && y < %du" % (cfg["DIAGONAL_THRESHOLD_LOW"],
+                                 cfg["DIAGONAL_THRESHOLD_LOW"]),
+         "DIR_SOUTH_WEST"),
+        ("y >= %du && %s" % (cfg["THRESHOLD_NORTH_Y"],
+                             in_range("x", cfg["CENTER_X_MIN"],
+                                      cfg["CENTER_X_MAX"])),
+         "DIR_NORTH"),
+        ("y <= %du && %s" % (cfg["THRESHOLD_SOUTH_Y"],
+                             in_range("x", cfg["CENTER_X_MIN"],
+                                      cfg["CENTER_X_MAX"])),
+         "DIR_SOUTH"),
+        # The generic cascade bounds y by CENTER_X_MAX for east/west;
+        # reproduced here so the two classifiers stay bit-identical.
+        ("x >= %du && %s" % (cfg["THRESHOLD_EAST_X"],
+                             in_range("y", cfg["CENTER_Y_MIN"],
+                                      cfg["CENTER_X_MAX"])),
+         "DIR_EAST"),
+        ("x <= %du && %s" % (cfg["THRESHOLD_WEST_X"],
+                             in_range("y", cfg["CENTER_Y_MIN"],
+                                      cfg["CENTER_X_MAX"])),
+         "DIR_WEST"),
+    ]
+
+    lines = [
+        "/*",
+        " * Generated by tools/generate_classifier.py -- do not edit.",
+        " * Specialized direction classifier for the thresholds in config.h:",
+        " * common-case (center) first, range checks folded into single",
+        " * unsigned subtract-and-compare tests.",
+        " */",
+        "",
+        "#ifndef JOYSTICK_GEN_H",
+        "#define JOYSTICK_GEN_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "static inline joystick_direction_t joystick_classify_gen(uint8_t x,",
+        "                                                         uint8_t y)",
+        "{",
+    ]
+    for condition, direction in checks:
+        lines.append("    if (%s) {" % condition)
+        lines.append("        return %s;" % direction)
+        lines.append("    }")
+    lines += [
+        "    return DIR_CENTER;",
+        "}",
+        "",
+        "#endif /* JOYSTICK_GEN_H */",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: generate_classifier.py <config.h> <output.h>")
+    cfg = parse_config(sys.argv[1])
+    with open(sys.argv[2], "w") as output:
+        output.write(generate(cfg))
+
+
+if __name__ == "__main__":
+    main()